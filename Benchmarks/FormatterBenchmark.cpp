@@ -0,0 +1,190 @@
+#include <GLib/formatter.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+	constexpr size_t DefaultIterations = 200000;
+	constexpr size_t BufferSize = 256;
+	constexpr auto NanoPerSecond = 1e9;
+
+	volatile size_t sink {}; // stops the optimiser removing the work
+
+	struct Result
+	{
+		std::string name;
+		double glib;
+		double printf;
+		double stream;
+	};
+
+	template <typename Function>
+	double Measure(size_t iterations, Function function)
+	{
+		size_t total {};
+		for (size_t i = 0; i < iterations / 10; ++i) // warm up
+		{
+			total += function().size();
+		}
+
+		const auto start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < iterations; ++i)
+		{
+			total += function().size();
+		}
+		const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+		sink = sink + total;
+		return elapsed.count() * NanoPerSecond / static_cast<double>(iterations);
+	}
+
+	template <typename... Ts>
+	std::string Printf(const char * format, const Ts &... ts)
+	{
+		std::array<char, BufferSize> buffer {};
+		const int len = ::snprintf(buffer.data(), buffer.size(), format, ts...); // NOLINT(cppcoreguidelines-pro-type-vararg,hicpp-vararg) by design
+		return {buffer.data(), static_cast<size_t>(len)};
+	}
+
+	template <typename... Ts>
+	std::string Stream(const Ts &... ts)
+	{
+		std::ostringstream stm;
+		((stm << ts << ' '), ...);
+		return stm.str();
+	}
+
+	template <typename GLibF, typename PrintfF, typename StreamF>
+	Result Run(std::string name, size_t iterations, GLibF glib, PrintfF printf, StreamF stream)
+	{
+		return {move(name), Measure(iterations, glib), Measure(iterations, printf), Measure(iterations, stream)};
+	}
+
+	std::vector<Result> RunAll(size_t iterations)
+	{
+		using GLib::Formatter;
+
+		const int i = 123456;
+		const double d = 3.14159;
+		const std::string s = "string value";
+		const char * c = "literal";
+
+		std::vector<Result> results;
+
+		results.push_back(Run(
+			"1 int", iterations, [&] { return Formatter::Format("{0}", i); }, [&] { return Printf("%d", i); },
+			[&] { return Stream(i); }));
+
+		results.push_back(Run(
+			"2 int", iterations, [&] { return Formatter::Format("{0} {1}", i, i); }, [&] { return Printf("%d %d", i, i); },
+			[&] { return Stream(i, i); }));
+
+		results.push_back(Run(
+			"4 int", iterations, [&] { return Formatter::Format("{0} {1} {2} {3}", i, i, i, i); },
+			[&] { return Printf("%d %d %d %d", i, i, i, i); }, [&] { return Stream(i, i, i, i); }));
+
+		results.push_back(Run(
+			"8 int", iterations, [&] { return Formatter::Format("{0} {1} {2} {3} {4} {5} {6} {7}", i, i, i, i, i, i, i, i); },
+			[&] { return Printf("%d %d %d %d %d %d %d %d", i, i, i, i, i, i, i, i); }, [&] { return Stream(i, i, i, i, i, i, i, i); }));
+
+		results.push_back(Run(
+			"int width 12", iterations, [&] { return Formatter::Format("{0,12}", i); }, [&] { return Printf("%12d", i); },
+			[&] {
+				std::ostringstream stm;
+				stm << std::setw(12) << i;
+				return stm.str();
+			}));
+
+		results.push_back(Run(
+			"int width -12", iterations, [&] { return Formatter::Format("{0,-12}", i); }, [&] { return Printf("%-12d", i); },
+			[&] {
+				std::ostringstream stm;
+				stm << std::left << std::setw(12) << i;
+				return stm.str();
+			}));
+
+		results.push_back(Run(
+			"int %x", iterations, [&] { return Formatter::Format("{0:%x}", i); }, [&] { return Printf("%x", i); },
+			[&] {
+				std::ostringstream stm;
+				stm << std::hex << i;
+				return stm.str();
+			}));
+
+		results.push_back(Run(
+			"double", iterations, [&] { return Formatter::Format("{0}", d); }, [&] { return Printf("%g", d); },
+			[&] { return Stream(d); }));
+
+		results.push_back(Run(
+			"double %.2f", iterations, [&] { return Formatter::Format("{0:%.2f}", d); }, [&] { return Printf("%.2f", d); },
+			[&] {
+				std::ostringstream stm;
+				stm << std::fixed << std::setprecision(2) << d;
+				return stm.str();
+			}));
+
+		results.push_back(Run(
+			"std::string", iterations, [&] { return Formatter::Format("{0}", s); }, [&] { return Printf("%s", s.c_str()); },
+			[&] { return Stream(s); }));
+
+		results.push_back(Run(
+			"const char *", iterations, [&] { return Formatter::Format("{0}", c); }, [&] { return Printf("%s", c); },
+			[&] { return Stream(c); }));
+
+		results.push_back(Run(
+			"mixed 4", iterations, [&] { return Formatter::Format("{0} {1:%.2f} {2} {3,10}", i, d, s, c); },
+			[&] { return Printf("%d %.2f %s %10s", i, d, s.c_str(), c); }, [&] { return Stream(i, d, s, c); }));
+
+		return results;
+	}
+
+	std::string Compiler()
+	{
+#ifdef _MSC_VER
+		return "msvc " + std::to_string(_MSC_VER);
+#else
+		return __VERSION__;
+#endif
+	}
+
+	void Print(std::ostream & out, const std::vector<Result> & results, size_t iterations)
+	{
+		out << "Formatter benchmark, ns per call, " << iterations << " iterations, " << Compiler() << "\n\n";
+		GLib::Formatter::Format(out, "{0,-16} {1,12} {2,12} {3,14} {4,10}\n", "case", "Formatter", "snprintf", "ostringstream",
+														"Fmt/printf");
+		for (const auto & r : results)
+		{
+			GLib::Formatter::Format(out, "{0,-16} {1,12:%.1f} {2,12:%.1f} {3,14:%.1f} {4,10:%.2f}\n", r.name, r.glib, r.printf, r.stream,
+															r.glib / r.printf);
+		}
+	}
+}
+
+// usage: FormatterBenchmark [iterations] [results file]
+int main(int argc, char * argv[])
+{
+	try
+	{
+		const std::vector<std::string> args {argv + 1, argv + argc}; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) main args
+		const size_t iterations = !args.empty() ? std::stoul(args[0]) : DefaultIterations;
+
+		const auto results = RunAll(iterations);
+		Print(std::cout, results, iterations);
+
+		if (args.size() > 1)
+		{
+			std::ofstream file(args[1]);
+			Print(file, results, iterations);
+		}
+		return 0;
+	}
+	catch (const std::exception & e)
+	{
+		std::cerr << e.what() << std::endl;
+		return 1;
+	}
+}
@@ -13,19 +13,13 @@ struct Chunk
 template <>
 struct GLib::Eval::Visitor<Chunk>
 {
-	static void Visit(const Chunk & chunk, const std::string & propertyName, const ValueVisitor & f)
+	static void Visit(const Chunk & chunk, std::string_view propertyName, const ValueVisitor & f)
 	{
-		if (propertyName == "cover")
-		{
-			return f(Value(chunk.cover));
-		}
-
-		if (propertyName == "size")
-		{
-			return f(Value(chunk.size));
-		}
-
-		throw std::runtime_error(std::string("Unknown property : '") + propertyName + '\'');
+		static constexpr auto properties = MakePropertyTable<Chunk>({
+			{"cover", [](const Chunk & value, const ValueVisitor & visitor) { visitor(Value(value.cover)); }},
+			{"size", [](const Chunk & value, const ValueVisitor & visitor) { visitor(Value(value.size)); }},
+		});
+		properties.Visit(chunk, propertyName, f);
 	}
 };
 
@@ -193,7 +193,7 @@ CoverageData Coverage::GetCoverageData() const
 	GLib::Flog::ScopeLog scopeLog(log, GLib::Flog::Level::Info, "GetCoverageData");
 	(void)scopeLog;
 
-	CaseInsensitiveMap<wchar_t, Functions> fileNameToFunctionMap;
+	GLib::NoCaseFlatMap<wchar_t, Functions> fileNameToFunctionMap;
 
 	for (const auto & [pid, process] : processes)
 	{
@@ -220,7 +220,7 @@ CoverageData Coverage::GetCoverageData() const
 
 		for (const auto & function : functions)
 		{
-			const FileLines & fileLines = function.FileLines();
+			const FunctionFileLines & fileLines = function.FileLines();
 
 			auto justFileNameIt = fileLines.find(filePath);
 			if (justFileNameIt == fileLines.end())
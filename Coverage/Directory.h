@@ -87,63 +87,21 @@ public:
 template <>
 struct GLib::Eval::Visitor<Directory>
 {
-	static void Visit(const Directory & dir, const std::string & propertyName, const ValueVisitor & f)
+	static void Visit(const Directory & dir, std::string_view propertyName, const ValueVisitor & f)
 	{
-		if (propertyName == "name")
-		{
-			return f(Value(dir.Name()));
-		}
-
-		if (propertyName == "link")
-		{
-			return f(Value(dir.Link()));
-		}
-
-		if (propertyName == "coveragePercent")
-		{
-			return f(Value(dir.CoveragePercent()));
-		}
-
-		if (propertyName == "coveredLines")
-		{
-			return f(Value(dir.CoveredLines()));
-		}
-
-		if (propertyName == "coverableLines")
-		{
-			return f(Value(dir.CoverableLines()));
-		}
-
-		if (propertyName == "coverageStyle")
-		{
-			return f(Value(dir.Style()));
-		}
-
-		if (propertyName == "minCoveragePercent")
-		{
-			return f(Value(dir.MinCoveragePercent()));
-		}
-
-		if (propertyName == "minCoverageStyle")
-		{
-			return f(Value(dir.MinCoverageStyle()));
-		}
-
-		if (propertyName == "coveredFunctions")
-		{
-			return f(Value(dir.CoveredFunctions()));
-		}
-
-		if (propertyName == "coverableFunctions")
-		{
-			return f(Value(dir.CoverableFunctions()));
-		}
-
-		if (propertyName == "coveredFunctionsPercent")
-		{
-			return f(Value(dir.CoveredFunctionsPercent()));
-		}
-
-		throw std::runtime_error(std::string("Unknown property : '") + propertyName + '\'');
+		static constexpr auto properties = MakePropertyTable<Directory>({
+			{"name", [](const Directory & value, const ValueVisitor & visitor) { visitor(Value(value.Name())); }},
+			{"link", [](const Directory & value, const ValueVisitor & visitor) { visitor(Value(value.Link())); }},
+			{"coveragePercent", [](const Directory & value, const ValueVisitor & visitor) { visitor(Value(value.CoveragePercent())); }},
+			{"coveredLines", [](const Directory & value, const ValueVisitor & visitor) { visitor(Value(value.CoveredLines())); }},
+			{"coverableLines", [](const Directory & value, const ValueVisitor & visitor) { visitor(Value(value.CoverableLines())); }},
+			{"coverageStyle", [](const Directory & value, const ValueVisitor & visitor) { visitor(Value(value.Style())); }},
+			{"minCoveragePercent", [](const Directory & value, const ValueVisitor & visitor) { visitor(Value(value.MinCoveragePercent())); }},
+			{"minCoverageStyle", [](const Directory & value, const ValueVisitor & visitor) { visitor(Value(value.MinCoverageStyle())); }},
+			{"coveredFunctions", [](const Directory & value, const ValueVisitor & visitor) { visitor(Value(value.CoveredFunctions())); }},
+			{"coverableFunctions", [](const Directory & value, const ValueVisitor & visitor) { visitor(Value(value.CoverableFunctions())); }},
+			{"coveredFunctionsPercent", [](const Directory & value, const ValueVisitor & visitor) { visitor(Value(value.CoveredFunctionsPercent())); }},
+		});
+		properties.Visit(dir, propertyName, f);
 	}
 };
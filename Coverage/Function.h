@@ -11,7 +11,7 @@ class Function
 	std::string className;
 	std::string functionName;
 
-	FileLines mutable fileLines;
+	FunctionFileLines mutable fileLines;
 
 public:
 	Function(std::string nameSpace, std::string className, std::string functionName)
@@ -24,7 +24,7 @@ public:
 	const std::string & ClassName() const { return className; }
 	const std::string & FunctionName() const { return functionName; }
 
-	const FileLines & FileLines() const
+	const FunctionFileLines & FileLines() const
 	{
 		return fileLines;
 	}
@@ -46,8 +46,8 @@ public:
 
 	bool Merge(const Function & added, const std::filesystem::path & path) const
 	{
-		auto addedIt = added.fileLines.find(path);
-		auto existingIt = fileLines.find(path);
+		auto addedIt = added.fileLines.find(path.native());
+		auto existingIt = fileLines.find(path.native());
 
 		if (existingIt == fileLines.end() || addedIt == added.fileLines.end())
 		{
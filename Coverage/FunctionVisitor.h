@@ -9,41 +9,32 @@
 template <>
 struct GLib::Eval::Visitor<FunctionCoverage>
 {
-	static void Visit(const FunctionCoverage & fc, const std::string & propertyName, const ValueVisitor & f)
+	static std::string Name(const FunctionCoverage & fc)
 	{
-		if (propertyName == "name")
+		std::ostringstream s;
+		if (!fc.NameSpace().empty())
 		{
-			std::ostringstream s;
-			if (!fc.NameSpace().empty())
-			{
-				GLib::Xml::Utils::Escape(fc.NameSpace(), s) << "::";
-			}
-			if (!fc.ClassName().empty())
-			{
-				GLib::Xml::Utils::Escape(fc.ClassName(), s) << "::";
-			}
-			GLib::Xml::Utils::Escape(fc.FunctionName(), s);
-			return f(Value(s.str()));
+			GLib::Xml::Utils::Escape(fc.NameSpace(), s) << "::";
 		}
-		if (propertyName == "line")
+		if (!fc.ClassName().empty())
 		{
-			return f(Value(fc.Line()));
-		}
-		if (propertyName == "coveredLines")
-		{
-			return f(Value(fc.CoveredLines()));
-		}
-		if (propertyName == "coverableLines")
-		{
-			return f(Value(fc.CoverableLines()));
-		}
-
-		if (propertyName == "cover")
-		{
-			return f(Value(fc.CoveredLines() !=0 ? LineCover::Covered : LineCover::NotCovered));
+			GLib::Xml::Utils::Escape(fc.ClassName(), s) << "::";
 		}
+		GLib::Xml::Utils::Escape(fc.FunctionName(), s);
+		return s.str();
+	}
 
-		throw std::runtime_error(std::string("Unknown property : '") + propertyName + '\'');
+	static void Visit(const FunctionCoverage & fc, std::string_view propertyName, const ValueVisitor & f)
+	{
+		static constexpr auto properties = MakePropertyTable<FunctionCoverage>({
+			{"name", [](const FunctionCoverage & value, const ValueVisitor & visitor) { visitor(Value(Name(value))); }},
+			{"line", [](const FunctionCoverage & value, const ValueVisitor & visitor) { visitor(Value(value.Line())); }},
+			{"coveredLines", [](const FunctionCoverage & value, const ValueVisitor & visitor) { visitor(Value(value.CoveredLines())); }},
+			{"coverableLines", [](const FunctionCoverage & value, const ValueVisitor & visitor) { visitor(Value(value.CoverableLines())); }},
+			{"cover", [](const FunctionCoverage & value, const ValueVisitor & visitor)
+				{ visitor(Value(value.CoveredLines() != 0 ? LineCover::Covered : LineCover::NotCovered)); }},
+		});
+		properties.Visit(fc, propertyName, f);
 	}
 };
 
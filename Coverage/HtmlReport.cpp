@@ -14,6 +14,7 @@
 #include <GLib/ConsecutiveFind.h>
 #include <GLib/Cpp/HtmlGenerator.h>
 #include <GLib/Html/TemplateEngine.h>
+#include <GLib/ParallelSplit.h>
 #include <GLib/Win/Resources.h>
 #include <GLib/Xml/Printer.h>
 #include <GLib/formatter.h>
@@ -284,16 +285,19 @@ void HtmlReport::GenerateSourceFile(std::filesystem::path & subPath, const FileC
 
 	std::vector<Line> lines;
 
-	for (const auto & sourceLine : GLib::Util::Splitter{source, "\n"})
+	for (const auto & chunk : GLib::Util::ParallelSplit(source, "\n"))
 	{
-		auto lineNumber = static_cast<unsigned int>(lines.size()+1);
-		LineCover cover {};
-		auto it = lc.find(lineNumber);
-		if (it != lc.end())
+		for (const auto & sourceLine : chunk)
 		{
-			cover = it->second == 0 ? LineCover::NotCovered : LineCover::Covered;
+			auto lineNumber = static_cast<unsigned int>(lines.size()+1);
+			LineCover cover {};
+			auto it = lc.find(lineNumber);
+			if (it != lc.end())
+			{
+				cover = it->second == 0 ? LineCover::NotCovered : LineCover::Covered;
+			}
+			lines.push_back({std::string {sourceLine}, {}, {}, cover, {}});
 		}
-		lines.push_back({sourceLine, {}, {}, cover, {}});
 	}
 
 	auto maxLineNumberWidth = static_cast<unsigned int>(floor(log10(lines.size()))) + 1;
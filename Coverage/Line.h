@@ -16,39 +16,17 @@ struct Line
 template <>
 struct GLib::Eval::Visitor<Line>
 {
-	static void Visit(const Line & line, const std::string & propertyName, const ValueVisitor & f)
+	static void Visit(const Line & line, std::string_view propertyName, const ValueVisitor & f)
 	{
-		if (propertyName == "cover")
-		{
-			return f(Value(line.cover));
-		}
-
-		if (propertyName == "number")
-		{
-			return f(Value(line.number));
-		}
-
-		if (propertyName == "paddedNumber")
-		{
-			return f(Value(line.paddedNumber));
-		}
-
-		if (propertyName == "text")
-		{
-			return f(Value(line.text));
-		}
-
-		if (propertyName == "hasLink")
-		{
-			return f(Value(line.hasLink));
-		}
-
-		if (propertyName == "hasNoLink") // todo !${value}
-		{
-			return f(Value(!line.hasLink));
-		}
-
-		throw std::runtime_error(std::string("Unknown property : '") + propertyName + '\'');
+		static constexpr auto properties = MakePropertyTable<Line>({
+			{"cover", [](const Line & value, const ValueVisitor & visitor) { visitor(Value(value.cover)); }},
+			{"number", [](const Line & value, const ValueVisitor & visitor) { visitor(Value(value.number)); }},
+			{"paddedNumber", [](const Line & value, const ValueVisitor & visitor) { visitor(Value(value.paddedNumber)); }},
+			{"text", [](const Line & value, const ValueVisitor & visitor) { visitor(Value(value.text)); }},
+			{"hasLink", [](const Line & value, const ValueVisitor & visitor) { visitor(Value(value.hasLink)); }},
+			{"hasNoLink", [](const Line & value, const ValueVisitor & visitor) { visitor(Value(!value.hasLink)); }}, // todo !${value}
+		});
+		properties.Visit(line, propertyName, f);
 	}
 };
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <GLib/NoCase.h>
+#include <GLib/NoCaseFlatMap.h>
 
 #include <filesystem>
 #include <map>
@@ -27,6 +28,8 @@ using Strings = CaseInsensitiveSet<char>;
 
 using Lines = std::map<unsigned int, bool>;
 using FileLines = CaseInsensitiveMap<wchar_t, Lines>;
+// looked up for each file of each function when merging coverage
+using FunctionFileLines = GLib::NoCaseFlatMap<wchar_t, Lines>;
 class Address;
 using Addresses = std::unordered_map<uint64_t, Address>;
 
@@ -0,0 +1,30 @@
+#include <GLib/formatter.h>
+
+#include <cstdint>
+#include <string_view>
+
+// libFuzzer entry point for the hand written format string parser
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t * data, size_t size)
+{
+	using GLib::FormatterDetail::StreamFunction;
+
+	const std::string_view format {reinterpret_cast<const char *>(data), size}; // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast) fuzz input
+
+	constexpr auto ArgumentCount = 3;
+	// printf formats are passed through to snprintf unchecked, so a fixed one is used when any is specified
+	const std::array<StreamFunction, ArgumentCount> args {
+		[](std::ostream & stm, const std::string & fmt) { GLib::FormatterPolicy::Printf::Format(stm, 12345, fmt.empty() ? fmt : std::string {"%d"}); },
+		[](std::ostream & stm, const std::string & fmt) { stm << fmt << "value"; },
+		[](std::ostream & stm, const std::string &) { stm << "\xE2\x86\x92"; }};
+
+	std::ostringstream stm;
+	try
+	{
+		GLib::FormatterDetail::AppendFormatHelper(stm, format, {args.data(), ArgumentCount});
+	}
+	catch (const std::logic_error &)
+	{
+		// invalid formats and out of range indices are expected
+	}
+	return 0;
+}
@@ -22,13 +22,13 @@ int APIENTRY wWinMain(_In_ HINSTANCE instance, _In_opt_ HINSTANCE prevInstance,
 		auto cmd = GLib::Cvt::w2a(cmdLine);
 		log.Info("Cmd: [{0}]",  cmd);
 
-		GLib::Util::Splitter split{cmd, " "};
+		GLib::Util::Splitter split{GLib::Util::NonOwning, cmd, " "};
 		unsigned int exitTime{1};
 		for (auto it = split.begin(); it!=split.end(); ++it)
 		{
 			if (*it=="-exitTime" && ++it != split.end())
 			{
-				if (!(std::istringstream{*it} >> exitTime))
+				if (!(std::istringstream{std::string{*it}} >> exitTime))
 				{
 					throw std::runtime_error("Parse error");
 				}
@@ -0,0 +1,84 @@
+#include <GLib/Arena.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "TestUtils.h"
+
+using GLib::Util::Arena;
+
+BOOST_AUTO_TEST_SUITE(ArenaTests)
+
+BOOST_AUTO_TEST_CASE(Alignment)
+{
+	Arena arena {1024};
+	for (size_t alignment : {1U, 2U, 8U, 64U, 256U})
+	{
+		(void) arena.Allocate(1, 1);
+		void * p = arena.Allocate(3, alignment);
+		BOOST_TEST(reinterpret_cast<uintptr_t>(p) % alignment == 0U); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast) address check
+	}
+
+	GLIB_CHECK_LOGIC_EXCEPTION(arena.Allocate(1, 3), "Alignment is not a power of two");
+	GLIB_CHECK_LOGIC_EXCEPTION(Arena {0}, "Block size is zero");
+}
+
+BOOST_AUTO_TEST_CASE(ResetReusesBlocks)
+{
+	Arena arena {1024};
+	void * first = arena.Allocate(100);
+	for (int i = 0; i < 100; ++i)
+	{
+		(void) arena.Allocate(100);
+	}
+	const size_t capacity = arena.Capacity();
+	BOOST_TEST(capacity >= 100U * 100U);
+
+	arena.Reset();
+	BOOST_TEST(first == arena.Allocate(100));
+	for (int i = 0; i < 100; ++i)
+	{
+		(void) arena.Allocate(100);
+	}
+	BOOST_TEST(capacity == arena.Capacity());
+
+	void * large = arena.Allocate(4096); // larger than a block
+	BOOST_TEST(large != nullptr);
+
+	arena.Release();
+	BOOST_TEST(arena.Capacity() == 0U);
+}
+
+BOOST_AUTO_TEST_CASE(MemoryResource)
+{
+	Arena arena;
+	GLib::Util::ArenaResource resource {arena};
+	{
+		std::pmr::vector<std::pmr::string> values {&resource};
+		for (int i = 0; i < 1000; ++i)
+		{
+			values.emplace_back("a string that is too long for the small string buffer " + std::to_string(i));
+		}
+		BOOST_TEST(values[999].get_allocator().resource() == &resource);
+		BOOST_TEST(values[999] == "a string that is too long for the small string buffer 999");
+	}
+	BOOST_TEST(arena.Capacity() != 0U);
+	arena.Reset();
+}
+
+BOOST_AUTO_TEST_CASE(ThreadDefault)
+{
+	Arena * main = &GLib::Util::ThreadArena();
+	BOOST_TEST(main == &GLib::Util::ThreadArena());
+	BOOST_TEST(main == &GLib::Util::ThreadArenaResource().Get());
+
+	Arena * other {};
+	std::thread([&] { other = &GLib::Util::ThreadArena(); }).join();
+	BOOST_TEST(main != other);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
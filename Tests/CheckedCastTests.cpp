@@ -3,6 +3,9 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <cmath>
+#include <vector>
+
 using namespace GLib::Util;
 
 namespace
@@ -97,4 +100,98 @@ BOOST_AUTO_TEST_CASE(IntCombos)
 		IsUnderflow);
 }
 
+BOOST_AUTO_TEST_CASE(Policies)
+{
+	BOOST_TEST(std::numeric_limits<short>::max() == (checked_cast<short, CastPolicy::Saturate>(100000)));
+	BOOST_TEST(std::numeric_limits<short>::min() == (checked_cast<short, CastPolicy::Saturate>(-100000)));
+	BOOST_TEST(0U == (checked_cast<unsigned int, CastPolicy::Saturate>(-1)));
+	BOOST_TEST(std::numeric_limits<int>::max() == (checked_cast<int, CastPolicy::Saturate>(std::numeric_limits<unsigned int>::max())));
+	BOOST_TEST(1234 == (checked_cast<short, CastPolicy::Saturate>(1234)));
+
+	BOOST_TEST(static_cast<unsigned char>(0x34) == (checked_cast<unsigned char, CastPolicy::Wrap>(0x1234)));
+	BOOST_TEST(std::numeric_limits<unsigned int>::max() == (checked_cast<unsigned int, CastPolicy::Wrap>(-1)));
+
+	BOOST_TEST(!(checked_cast<short, CastPolicy::Optional>(100000)).has_value());
+	BOOST_TEST(!(checked_cast<unsigned short, CastPolicy::Optional>(-1)).has_value());
+	BOOST_TEST(1234 == *(checked_cast<short, CastPolicy::Optional>(1234)));
+	BOOST_TEST(1234 == *(checked_cast<long long, CastPolicy::Optional>(1234)));
+
+	BOOST_TEST(1234 == (checked_cast<short, CastPolicy::Assert>(1234)));
+}
+
+BOOST_AUTO_TEST_CASE(FloatingPoint)
+{
+	BOOST_TEST(1234.0 == checked_cast<double>(1234));
+	BOOST_TEST(1.5F == checked_cast<float>(1.5));
+	BOOST_TEST(std::isinf(checked_cast<float>(std::numeric_limits<double>::infinity())));
+	BOOST_TEST(std::isnan(checked_cast<float>(std::numeric_limits<double>::quiet_NaN())));
+	BOOST_CHECK_EXCEPTION(checked_cast<float>(1e300), Exception, IsOverflow);
+	BOOST_CHECK_EXCEPTION(checked_cast<float>(-1e300), Exception, IsUnderflow);
+
+	BOOST_TEST(1234 == checked_cast<int>(1234.9));
+	BOOST_TEST(-128 == checked_cast<signed char>(-128.9));
+	BOOST_TEST(127 == checked_cast<signed char>(127.9));
+	BOOST_TEST(0U == checked_cast<unsigned int>(-0.9));
+	BOOST_CHECK_EXCEPTION(checked_cast<signed char>(-129.0), Exception, IsUnderflow);
+	BOOST_CHECK_EXCEPTION(checked_cast<signed char>(128.0), Exception, IsOverflow);
+	BOOST_CHECK_EXCEPTION(checked_cast<unsigned int>(-1.0), Exception, IsUnderflow);
+	BOOST_CHECK_EXCEPTION(checked_cast<int>(std::numeric_limits<double>::quiet_NaN()), Exception,
+		[](const Exception & e) { return e.what() == std::string("Not a number"); });
+
+	// the bounds of 64 bit targets are not all representable as double
+	BOOST_TEST(std::numeric_limits<long long>::min() == checked_cast<long long>(-9223372036854775808.0));
+	BOOST_CHECK_EXCEPTION(checked_cast<long long>(9223372036854775808.0), Exception, IsOverflow);
+	BOOST_CHECK_EXCEPTION(checked_cast<unsigned long long>(18446744073709551616.0), Exception, IsOverflow);
+
+	BOOST_TEST(0 == (checked_cast<int, CastPolicy::Saturate>(std::numeric_limits<double>::quiet_NaN())));
+	BOOST_TEST(std::numeric_limits<int>::max() == (checked_cast<int, CastPolicy::Saturate>(1e10)));
+	BOOST_TEST(!(checked_cast<int, CastPolicy::Optional>(-1e10)).has_value());
+
+	const std::vector<double> source {1.5, -2.5, 1e10};
+	BOOST_CHECK_EXCEPTION(checked_cast_range<int>(GLib::MakeSpan(source.data(), source.size())), RangeCastError,
+		[](const RangeCastError & e) { return e.Index() == 2; });
+}
+
+BOOST_AUTO_TEST_CASE(Range)
+{
+	std::vector<long long> source(1000);
+	for (size_t i = 0; i < source.size(); ++i)
+	{
+		source[i] = static_cast<long long>(i) * 1000 - 500000;
+	}
+
+	const std::vector<int> target = checked_cast_range<int>(GLib::MakeSpan(source.data(), source.size()));
+	BOOST_TEST(target.size() == source.size());
+	BOOST_TEST(target[0] == -500000);
+	BOOST_TEST(target[999] == 499000);
+
+	std::vector<short> shorts(source.size(), 7);
+	BOOST_CHECK_EXCEPTION(checked_cast_range(GLib::MakeSpan(source.data(), source.size()), GLib::MakeMutableSpan(shorts.data(), shorts.size())),
+		RangeCastError, [](const RangeCastError & e) { return e.Index() == 0 && e.what() == std::string("Underflow at index 0"); });
+	BOOST_TEST(shorts[0] == 7); // the failing block is not written
+	BOOST_TEST(shorts[16] == 7);
+	BOOST_CHECK_THROW(checked_cast_range(GLib::MakeSpan(source.data(), source.size()), GLib::MakeMutableSpan(shorts.data(), 10)), std::logic_error);
+
+	std::vector<int> ints(40, 1);
+	ints[33] = -1;
+	BOOST_CHECK_EXCEPTION(checked_cast_range<unsigned int>(GLib::MakeSpan(ints.data(), ints.size())), RangeCastError,
+		[](const RangeCastError & e) { return e.Index() == 33; });
+	std::vector<unsigned int> unsignedInts(40, 1);
+	unsignedInts[17] = std::numeric_limits<unsigned int>::max();
+	BOOST_CHECK_EXCEPTION(checked_cast_range<int>(GLib::MakeSpan(unsignedInts.data(), unsignedInts.size())), RangeCastError,
+		[](const RangeCastError & e) { return e.Index() == 17; });
+
+	source.assign(200, 1);
+	source[130] = std::numeric_limits<long long>::max();
+	source[150] = std::numeric_limits<long long>::min();
+	BOOST_CHECK_EXCEPTION(checked_cast_range<int>(GLib::MakeSpan(source.data(), source.size())), RangeCastError,
+		[](const RangeCastError & e) { return e.Index() == 130 && e.what() == std::string("Overflow at index 130"); });
+
+	BOOST_CHECK_EXCEPTION(checked_cast_range<unsigned short>(GLib::MakeSpan(source.data() + 131, 30)), RangeCastError,
+		[](const RangeCastError & e) { return e.Index() == 19 && e.what() == std::string("Underflow at index 19"); });
+
+	BOOST_TEST(checked_cast_range<unsigned short>(GLib::MakeSpan(source.data(), 5)).size() == 5U);
+	BOOST_TEST(checked_cast_range<int>(GLib::Span<long long> {}).empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
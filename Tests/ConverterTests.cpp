@@ -1,4 +1,6 @@
 
+#include <GLib/Utf8Validator.h>
+
 #include <boost/test/unit_test.hpp>
 
 #include "TestUtils.h"
@@ -40,4 +42,145 @@ BOOST_AUTO_TEST_SUITE(ConverterTests)
 		BOOST_TEST(utf8Value == GLib::Cvt::w2a(utf16Value));
 	}
 
+	BOOST_AUTO_TEST_CASE(RoundTripAllCodePoints)
+	{
+		std::wstring wide;
+		for (char32_t c = 1; c <= 0x10FFFF; ++c)
+		{
+			if (c >= 0xD800 && c < 0xE000)
+			{
+				continue;
+			}
+			if constexpr (sizeof(wchar_t) == 2)
+			{
+				if (c >= 0x10000)
+				{
+					wide += static_cast<wchar_t>(0xD800 + ((c - 0x10000) >> 10));
+					wide += static_cast<wchar_t>(0xDC00 + ((c - 0x10000) & 0x3FF));
+					continue;
+				}
+			}
+			wide += static_cast<wchar_t>(c);
+		}
+
+		const std::string utf8 = GLib::Cvt::w2a(wide);
+		BOOST_TEST(utf8.size() == 127U + 1920U * 2 + (63488U - 2048U) * 3 + 1048576U * 4);
+		BOOST_TEST((wide == GLib::Cvt::a2w(utf8)));
+	}
+
+	BOOST_AUTO_TEST_CASE(InvalidUtf8)
+	{
+		for (const char * value : {"\x80", "\xC3", "\xC0\xAF", "\xE0\x80\xAF", "\xED\xA0\x80", "\xF4\x90\x80\x80", "\xF8\x88\x80\x80\x80", "a\xE2\x82"})
+		{
+			GLIB_CHECK_RUNTIME_EXCEPTION(GLib::Cvt::a2w(value), "Invalid UTF-8");
+		}
+
+		std::wstring wide {L"abc"};
+		GLIB_CHECK_RUNTIME_EXCEPTION(GLib::Cvt::AppendA2W(wide, "def\xFF"), "Invalid UTF-8");
+		BOOST_TEST((wide == L"abc"));
+
+		std::string narrow {"abc"};
+		GLIB_CHECK_RUNTIME_EXCEPTION(GLib::Cvt::AppendW2A(narrow, std::wstring(1, static_cast<wchar_t>(0xDC00))), "Invalid wide string");
+		BOOST_TEST(narrow == "abc");
+	}
+
+	BOOST_AUTO_TEST_CASE(Append)
+	{
+		std::wstring wide;
+		wide.reserve(64);
+		const auto * data = wide.data();
+		GLib::Cvt::AppendA2W(wide, "ab");
+		GLib::Cvt::AppendA2W(wide, "\xE2\x82\xAC");
+		BOOST_TEST((wide == L"ab\u20AC"));
+		BOOST_TEST(data == wide.data());
+
+		std::string narrow = "x";
+		GLib::Cvt::AppendW2A(narrow, L"\u00DF\U00010437");
+		BOOST_TEST(narrow == "x\xC3\x9F\xF0\x90\x90\xB7");
+	}
+
+	BOOST_AUTO_TEST_CASE(ExactSize)
+	{
+		std::string narrow;
+		narrow.shrink_to_fit();
+		GLib::Cvt::AppendW2A(narrow, std::wstring(100, L'\u00DF'));
+		BOOST_TEST(200U == narrow.size());
+		BOOST_TEST(narrow.capacity() < 300U); // not sized for the worst case and trimmed
+
+		std::wstring wide;
+		wide.shrink_to_fit();
+		std::string chinese;
+		for (int i = 0; i < 100; ++i)
+		{
+			chinese += "\xE4\xB8\xAD";
+		}
+		GLib::Cvt::AppendA2W(wide, chinese);
+		BOOST_TEST(100U == wide.size());
+		BOOST_TEST(wide.capacity() < 200U);
+	}
+
+	BOOST_AUTO_TEST_CASE(StackOrHeapBuffer)
+	{
+		GLib::Util::WideCharBuffer wide;
+		BOOST_TEST(3U == GLib::Cvt::a2w("a\xC3\x9F" "c", wide));
+		BOOST_TEST((std::wstring_view {wide.Get()} == L"a\u00DF" L"c"));
+
+		const std::string longValue(1000, 'x');
+		BOOST_TEST(1000U == GLib::Cvt::a2w(longValue, wide));
+		BOOST_TEST((std::wstring_view {wide.Get()} == std::wstring(1000, L'x')));
+
+		GLib::Util::CharBuffer narrow;
+		BOOST_TEST(4U == GLib::Cvt::w2a(L"\U00024B62", narrow));
+		BOOST_TEST(std::string_view {narrow.Get()} == "\xF0\xA4\xAD\xA2");
+	}
+
+	BOOST_AUTO_TEST_CASE(Utf8Validation)
+	{
+		BOOST_TEST(GLib::Util::IsValidUtf8(""));
+		BOOST_TEST(GLib::Util::IsValidUtf8(std::string(100, 'a') + "\xE2\x82\xAC\xF0\x90\x90\xB7\xC3\x9F\xED\x9F\xBF\xF4\x8F\xBF\xBF"));
+
+		for (const char * value : {"\x80", "\xC1\xBF", "\xE0\x9F\xBF", "\xED\xA0\x80", "\xF0\x8F\xBF\xBF", "\xF4\x90\x80\x80", "\xF5\x80\x80\x80",
+															 "\xFF", "\xC3", "\xE2\x82"})
+		{
+			BOOST_TEST(!GLib::Util::IsValidUtf8(value), value);
+		}
+
+		GLib::Util::Utf8Validator validator;
+		BOOST_TEST(std::string_view::npos == validator.Feed(std::string(40, 'x') + "\xC3"));
+		BOOST_TEST(std::string_view::npos == validator.Feed("\x9F" "abc\xF0\x90"));
+		BOOST_TEST(2U == validator.Pending());
+		BOOST_TEST(std::string_view::npos == validator.Feed("\x90"));
+		BOOST_TEST(45U == validator.Finish());
+		BOOST_TEST(45U == validator.Feed("x"));
+
+		GLib::Util::Utf8Validator other;
+		BOOST_TEST(std::string_view::npos == other.Feed("abc"));
+		BOOST_TEST(5U == other.Feed("de\x80"));
+	}
+
+	BOOST_AUTO_TEST_CASE(Utf8ValidationChunked)
+	{
+		const std::string valid = "a\xE2\x82\xAC" "b\xF0\x90\x90\xB7" "c\xC3\x9F";
+		const std::string invalid = "a\xE2\x82\xAC" "b\xF0\x90\x28\xB7";
+		for (size_t chunk = 1; chunk <= valid.size(); ++chunk)
+		{
+			GLib::Util::Utf8Validator validator;
+			size_t result = std::string_view::npos;
+			for (size_t i = 0; i < valid.size() && result == std::string_view::npos; i += chunk)
+			{
+				result = validator.Feed(std::string_view {valid}.substr(i, chunk));
+			}
+			BOOST_TEST(result == std::string_view::npos);
+			BOOST_TEST(validator.Finish() == std::string_view::npos);
+
+			GLib::Util::Utf8Validator invalidValidator;
+			result = std::string_view::npos;
+			for (size_t i = 0; i < invalid.size() && result == std::string_view::npos; i += chunk)
+			{
+				result = invalidValidator.Feed(std::string_view {invalid}.substr(i, chunk));
+			}
+			BOOST_TEST(result == 5U);
+		}
+	}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
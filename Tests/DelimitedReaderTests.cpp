@@ -0,0 +1,105 @@
+#include <GLib/DelimitedReader.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <sstream>
+
+#include "TestUtils.h"
+
+namespace
+{
+	using Records = std::vector<std::vector<std::string>>;
+
+	Records ReadAll(std::string_view value, const GLib::Util::DelimitedFormat & format = {}, size_t chunkSize = 64 * 1024)
+	{
+		GLib::Util::DelimitedReader reader {GLib::Util::ViewSource {value}, format, chunkSize};
+		Records records;
+		std::vector<std::string_view> fields;
+		while (reader.Next(fields))
+		{
+			records.emplace_back(fields.begin(), fields.end());
+		}
+		return records;
+	}
+
+	void Check(const Records & expected, const Records & actual)
+	{
+		BOOST_TEST_REQUIRE(expected.size() == actual.size());
+		for (size_t i = 0; i < expected.size(); ++i)
+		{
+			BOOST_CHECK_EQUAL_COLLECTIONS(expected[i].begin(), expected[i].end(), actual[i].begin(), actual[i].end());
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE(DelimitedReaderTests)
+
+BOOST_AUTO_TEST_CASE(Csv)
+{
+	const std::string value = "a,b,c\r\n1,,3\n\"x,y\",\"say \"\"hi\"\"\",\"multi\nline\"\n";
+	const Records expected {{"a", "b", "c"}, {"1", "", "3"}, {"x,y", "say \"hi\"", "multi\nline"}};
+	Check(expected, ReadAll(value, GLib::Util::DelimitedFormat::Csv()));
+}
+
+BOOST_AUTO_TEST_CASE(NoTrailingNewline)
+{
+	Check({{"a", "b"}, {"c", ""}}, ReadAll("a,b\nc,"));
+	Check({{""}, {"a"}}, ReadAll("\na\n"));
+	Check({}, ReadAll(""));
+}
+
+BOOST_AUTO_TEST_CASE(MultipleDelimiters)
+{
+	GLib::Util::DelimitedFormat format;
+	format.delimiters = ",;|";
+	Check({{"a", "b", "c", "d"}}, ReadAll("a,b;c|d", format));
+}
+
+BOOST_AUTO_TEST_CASE(Tsv)
+{
+	const std::string value = "name\tvalue\nte\\\tb\t\"quoted\"\nback\\\\slash\tx\n";
+	const Records expected {{"name", "value"}, {"te\tb", "\"quoted\""}, {"back\\slash", "x"}};
+	Check(expected, ReadAll(value, GLib::Util::DelimitedFormat::Tsv()));
+}
+
+BOOST_AUTO_TEST_CASE(SmallChunks)
+{
+	std::string value;
+	Records expected;
+	for (int i = 0; i < 100; ++i)
+	{
+		const std::string n = std::to_string(i);
+		value += n + ",\"q" + n + "\"\"\"," + std::string(static_cast<size_t>(i), 'x') + "\r\n";
+		expected.push_back({n, "q" + n + "\"", std::string(static_cast<size_t>(i), 'x')});
+	}
+
+	for (size_t chunkSize : {1, 2, 3, 7, 64})
+	{
+		Check(expected, ReadAll(value, {}, chunkSize));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(Stream)
+{
+	std::istringstream stream {"a,b\n\"c\",d\n"};
+	GLib::Util::DelimitedReader reader {GLib::Util::StreamSource {stream}, {}, 4};
+	std::vector<std::string_view> fields;
+	BOOST_TEST(reader.Next(fields));
+	BOOST_TEST(fields == (std::vector<std::string_view> {"a", "b"}));
+	BOOST_TEST(reader.Next(fields));
+	BOOST_TEST(fields == (std::vector<std::string_view> {"c", "d"}));
+	BOOST_TEST(!reader.Next(fields));
+}
+
+BOOST_AUTO_TEST_CASE(Errors)
+{
+	GLIB_CHECK_RUNTIME_EXCEPTION(ReadAll("a,\"b\n"), "Unterminated quoted field");
+	GLIB_CHECK_RUNTIME_EXCEPTION(ReadAll("\"a\"b,c\n"), "Malformed quoted field");
+	GLIB_CHECK_RUNTIME_EXCEPTION(ReadAll("a\\", GLib::Util::DelimitedFormat::Tsv()), "Trailing escape");
+
+	GLib::Util::DelimitedFormat format;
+	format.delimiters.clear();
+	GLIB_CHECK_LOGIC_EXCEPTION(ReadAll("a", format), "Delimiter is empty");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
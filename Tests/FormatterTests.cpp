@@ -1,10 +1,12 @@
 
+#include <GLib/Arena.h>
 #include <GLib/formatter.h>
 
 #include <boost/test/unit_test.hpp>
 
 #include <chrono>
 
+#include "TestUtils.h"
 #include "Xyzzy.h"
 
 namespace
@@ -21,6 +23,43 @@ namespace
 #else
 #endif
 
+	struct TestMoneyPunct : std::moneypunct<wchar_t, false>
+	{
+	protected:
+		wchar_t do_decimal_point() const override { return L'.'; }
+		wchar_t do_thousands_sep() const override { return L','; }
+		std::string do_grouping() const override { return "\3"; }
+		string_type do_curr_symbol() const override { return L"\u00a3"; }
+		string_type do_negative_sign() const override { return L"-"; }
+		int do_frac_digits() const override { return 2; }
+		pattern do_pos_format() const override { return { symbol, sign, none, value }; }
+		pattern do_neg_format() const override { return { sign, symbol, none, value }; }
+	};
+
+	struct SpacedMoneyPunct : TestMoneyPunct
+	{
+	protected:
+		string_type do_curr_symbol() const override { return L"EUR"; }
+		pattern do_pos_format() const override { return { symbol, space, sign, value }; }
+	};
+
+	std::string WidePutTime(const tm & tm, const std::locale & locale, const std::string & format)
+	{
+		std::wostringstream s;
+		s.imbue(locale);
+		s << std::put_time(&tm, GLib::Cvt::a2w(format).c_str());
+		return GLib::Cvt::w2a(s.str());
+	}
+
+	std::string WidePutMoney(long double value, const std::locale & locale, wchar_t fill = L' ')
+	{
+		std::wostringstream s;
+		s.imbue(locale);
+		(void) s.fill(fill);
+		s << std::showbase << std::put_money(value);
+		return GLib::Cvt::w2a(s.str());
+	}
+
 	tm MakeTm(int tm_sec, int tm_min, int tm_hour, int tm_mday, int tm_mon, int tm_year, int tm_wday, int tm_yday, int tm_isdst)
 	{
 		return { tm_sec, tm_min, tm_hour, tm_mday, tm_mon, tm_year, tm_wday, tm_yday, tm_isdst
@@ -52,6 +91,15 @@ BOOST_AUTO_TEST_CASE(BasicTest)
 	}
 }
 
+BOOST_AUTO_TEST_CASE(FormatToResource)
+{
+	GLib::Util::Arena arena;
+	GLib::Util::ArenaResource resource {arena};
+	const std::pmr::string s = Formatter::Format(&resource, "{0} {1,-4}|{2,4}", 1, "2", std::string("3"));
+	BOOST_TEST(s == "1 2   |   3");
+	BOOST_TEST(s.get_allocator().resource() == &resource);
+}
+
 BOOST_AUTO_TEST_CASE(TestEmptyFormatOk)
 {
 	std::string s = Formatter::Format("", 1, 2, 3);
@@ -333,6 +381,90 @@ BOOST_AUTO_TEST_CASE(TestTimePoint)
 	BOOST_TEST("06 Nov 1967, 18:00:00" == s.str());
 }
 
+BOOST_AUTO_TEST_CASE(TestTimeMatchesPutTime)
+{
+	const tm am = MakeTm( 5,7,9, 6,10,67, 1,309, 0 );
+	const tm pm = MakeTm( 59,59,23, 31,11,99, 5,364, 0 );
+	const std::locale locale = std::locale::classic();
+
+	for (const auto & format : { "%d %b %Y, %H:%M:%S", "%a %A %b %B %h", "%C %e %I %j %m %p %u %w %y", "%D %F %R %T", "%%%n%t" })
+	{
+		std::string direct;
+		BOOST_TEST(GLib::LocaleFormat::FormatTime(direct, am, format, locale));
+		BOOST_TEST(WidePutTime(am, locale, format) == direct);
+
+		direct.clear();
+		BOOST_TEST(GLib::LocaleFormat::FormatTime(direct, pm, format, locale));
+		BOOST_TEST(WidePutTime(pm, locale, format) == direct);
+	}
+
+	std::ostringstream s;
+	s.imbue(locale);
+	Formatter::Format(s, "{0}", am);
+	BOOST_TEST("06 Nov 1967, 09:07:05" == s.str());
+}
+
+BOOST_AUTO_TEST_CASE(TestTimeUncommonSpecifierFallsBack)
+{
+	const tm tm = MakeTm( 0,0,18, 6,10,67, 1,309, 0 );
+	std::string direct;
+	BOOST_TEST(!GLib::LocaleFormat::FormatTime(direct, tm, "%d %c", std::locale::classic()));
+	BOOST_TEST(direct.empty());
+
+	std::ostringstream s;
+	s.imbue(std::locale::classic());
+	Formatter::Format(s, "{0:%c}", tm);
+	BOOST_TEST(WidePutTime(tm, std::locale::classic(), "%c") == s.str());
+}
+
+BOOST_AUTO_TEST_CASE(TestMoneyMatchesPutMoney)
+{
+	const std::locale locale(std::locale::classic(), new TestMoneyPunct);
+
+	for (long double value : { 123456.7L, -123456.7L, 0.0L, 5.0L, -5.0L, 99.0L, 100.0L, 123456789012.0L })
+	{
+		std::ostringstream s;
+		s.imbue(locale);
+		Formatter::Format(s, "{0}", GLib::Money { value });
+		BOOST_TEST(WidePutMoney(value, locale) == s.str());
+	}
+
+	std::ostringstream s;
+	s.imbue(locale);
+	Formatter::Format(s, "{0}", GLib::Money { 123456.7L });
+	BOOST_TEST("\xc2\xa3" "1,234.57" == s.str());
+
+	std::ostringstream c;
+	c.imbue(std::locale::classic());
+	Formatter::Format(c, "{0}", GLib::Money { -123456.7L });
+	BOOST_TEST(WidePutMoney(-123456.7L, std::locale::classic()) == c.str());
+}
+
+BOOST_AUTO_TEST_CASE(TestMoneySpaceUsesFill)
+{
+	const std::locale test(std::locale::classic(), new TestMoneyPunct);
+	const std::locale spaced(std::locale::classic(), new SpacedMoneyPunct);
+
+	std::ostringstream s;
+	s.imbue(spaced);
+	Formatter::Format(s, "{0}", GLib::Money { 123456.7L });
+	BOOST_TEST(WidePutMoney(123456.7L, spaced) == s.str());
+	BOOST_TEST("EUR 1,234.57" == s.str());
+
+	std::ostringstream f;
+	f.imbue(spaced);
+	(void) f.fill('*');
+	Formatter::Format(f, "{0}", GLib::Money { 123456.7L });
+	BOOST_TEST(WidePutMoney(123456.7L, spaced, L'*') == f.str());
+	BOOST_TEST("EUR*1,234.57" == f.str());
+
+	// unnamed locales are cached by facet, each keeps its own symbols
+	std::ostringstream t;
+	t.imbue(test);
+	Formatter::Format(t, "{0}", GLib::Money { 123456.7L });
+	BOOST_TEST("\xc2\xa3" "1,234.57" == t.str());
+}
+
 BOOST_AUTO_TEST_CASE(TestPad)
 {
 	std::string s = Formatter::Format("{0},{1,4},{2}", 0, 1, 2);
@@ -342,6 +474,110 @@ BOOST_AUTO_TEST_CASE(TestPad)
 	BOOST_TEST("0,1   ,2" == s);
 }
 
+BOOST_AUTO_TEST_CASE(TestPadWholeArgument)
+{
+	CopyCheck c;
+	std::string s = Formatter::Format("[{0,6}][{0,-6}]", c);
+	BOOST_TEST("[   0:0][0:0   ]" == s);
+
+	s = Formatter::Format("[{0,6:fmt}]", Xyzzy());
+	BOOST_TEST("[fmt:plover]" == s);
+
+	s = Formatter::Format("[{0,12:fmt}]", Xyzzy());
+	BOOST_TEST("[  fmt:plover]" == s);
+}
+
+BOOST_AUTO_TEST_CASE(TestPadUtf8Width)
+{
+	std::string s = Formatter::Format("[{0,5}][{0,-5}]", "\xc2\xa3" "12");
+	BOOST_TEST("[  \xc2\xa3" "12][\xc2\xa3" "12  ]" == s);
+
+	s = Formatter::Format("[{0,2}]", "\xE2\x86\x92\xE2\x86\x92\xE2\x86\x92");
+	BOOST_TEST("[\xE2\x86\x92\xE2\x86\x92\xE2\x86\x92]" == s);
+}
+
+BOOST_AUTO_TEST_CASE(TestPadLeavesStreamState)
+{
+	std::ostringstream stm;
+	stm << std::boolalpha;
+	stm.fill('*');
+	Formatter::Format(stm, "{0,-6}|{1,6}|", true, 1.5);
+	BOOST_TEST("true**|***1.5|" == stm.str());
+
+	stm << std::setw(4) << 1;
+	BOOST_TEST("true**|***1.5|***1" == stm.str());
+	BOOST_TEST(0 == stm.width());
+
+	stm.str({});
+	stm.setstate(std::ios_base::failbit);
+	Formatter::Format(stm, "{0,6}", 1);
+	BOOST_TEST(stm.str().empty()); // nothing is padded once the stream has failed
+}
+
+BOOST_AUTO_TEST_CASE(TestNamedArguments)
+{
+	const GLib::PreparedFormat format { "{user} took {latency:%.2f}ms, {latency,8:%.1f} {0}", { "user", "latency" } };
+	std::string s = Formatter::Format(format, "fred", 12.345);
+	BOOST_TEST("fred took 12.35ms,     12.3 fred" == s);
+
+	s = Formatter::Format(format, "barney", 1.0);
+	BOOST_TEST("barney took 1.00ms,      1.0 barney" == s);
+}
+
+BOOST_AUTO_TEST_CASE(TestNamedArgumentErrors)
+{
+	const GLib::FormatNames names { "user" };
+	GLIB_CHECK_LOGIC_EXCEPTION(GLib::PreparedFormat("{missing}", names), "Unknown argument name : missing");
+	BOOST_CHECK_EXCEPTION(GLib::PreparedFormat("{user", names), std::logic_error, IsInvalidFormat);
+	BOOST_CHECK_EXCEPTION(GLib::PreparedFormat("{user x}", names), std::logic_error, IsInvalidFormat);
+	BOOST_CHECK_EXCEPTION(GLib::PreparedFormat("{user-}", names), std::logic_error, IsInvalidFormat);
+	BOOST_CHECK_EXCEPTION(Formatter::Format("{user}", 1), std::logic_error, IsInvalidFormat);
+}
+
+BOOST_AUTO_TEST_CASE(TestPreparedFormat)
+{
+	const GLib::PreparedFormat format { "{{{name,-5}}} {value:%04d}|{0}", { "name", "value" } };
+	BOOST_TEST(6U == format.Items().size());
+
+	BOOST_TEST("{a    } 0001|a" == Formatter::Format(format, "a", 1));
+	BOOST_TEST("{bcdef} 0023|bcdef" == Formatter::Format(format, "bcdef", 23));
+
+	std::ostringstream stm;
+	Formatter::Format(stm, format, "c", 4);
+	BOOST_TEST("{c    } 0004|c" == stm.str());
+}
+
+BOOST_AUTO_TEST_CASE(TestPreparedFormatErrors)
+{
+	BOOST_CHECK_EXCEPTION(GLib::PreparedFormat("{0"), std::logic_error, IsInvalidFormat);
+	GLIB_CHECK_LOGIC_EXCEPTION(GLib::PreparedFormat("{name}"), "Unknown argument name : name");
+
+	const GLib::PreparedFormat format { "{1}" };
+	BOOST_CHECK_EXCEPTION(Formatter::Format(format, 0), std::logic_error, IsIndexOutOfRange);
+}
+
+BOOST_AUTO_TEST_CASE(TestFormatRows)
+{
+	const std::vector<int> ids { 1, 22, 333 };
+	const std::array<double, 3> values { 1.5, 22.25, 333.125 };
+	const std::vector<std::string> names { "one", "two", "three" };
+
+	const GLib::PreparedFormat format { "{id,4}|{name,-6}|{value:%.2f}\n", { "id", "name", "value" } };
+	std::string s = Formatter::FormatRows(format, ids, names, GLib::MakeSpan(values.data(), values.size()));
+	BOOST_TEST("   1|one   |1.50\n  22|two   |22.25\n 333|three |333.12\n" == s);
+
+	std::ostringstream stm;
+	Formatter::FormatRows(stm, GLib::PreparedFormat { "{0}," }, std::vector<int> {});
+	BOOST_TEST(stm.str().empty());
+}
+
+BOOST_AUTO_TEST_CASE(TestFormatRowsSizeMismatch)
+{
+	const std::vector<int> ids { 1, 2 };
+	const std::vector<std::string> names { "one" };
+	GLIB_CHECK_LOGIC_EXCEPTION(Formatter::FormatRows(GLib::PreparedFormat { "{0}{1}" }, ids, names), "Column sizes differ");
+}
+
 BOOST_AUTO_TEST_CASE(CustomTypeNoFormat)
 {
 	Xyzzy plugh;
@@ -1,8 +1,16 @@
 
 #include <GLib/IcuUtils.h>
+#include <GLib/NfcWriter.h>
+#include <GLib/Xml/Iterator.h>
 
 #include <boost/test/unit_test.hpp>
 
+#include "TestUtils.h"
+
+#include <future>
+#include <map>
+#include <vector>
+
 BOOST_AUTO_TEST_SUITE(IcuUtilsTests)
 
 	BOOST_AUTO_TEST_CASE(CompareSimpleCases)
@@ -57,4 +65,160 @@ BOOST_AUTO_TEST_SUITE(IcuUtilsTests)
 		BOOST_TEST("\xC4\xB0" == GLib::IcuUtils::ToUpper("i", "tr"));
 	}
 
+	BOOST_AUTO_TEST_CASE(LowerUpperBufferSizes)
+	{
+		BOOST_TEST("" == GLib::IcuUtils::ToLower(""));
+		BOOST_TEST("" == GLib::IcuUtils::ToUpper(""));
+
+		const std::string upper(1000, 'A');
+		const std::string lower(1000, 'a');
+		BOOST_TEST(lower == GLib::IcuUtils::ToLower(upper));
+		BOOST_TEST(upper == GLib::IcuUtils::ToUpper(lower));
+
+		std::string sharpS;
+		for (int i = 0; i < 200; ++i)
+		{
+			sharpS += "\xC3\x9F";
+		}
+		BOOST_TEST(std::string(400, 'S') == GLib::IcuUtils::ToUpper(sharpS));
+	}
+
+	BOOST_AUTO_TEST_CASE(CachedPerThreadAndLocale)
+	{
+		auto compare = []
+		{
+			bool ok = true;
+			for (int i = 0; i < 1000; ++i)
+			{
+				ok &= GLib::IcuUtils::CompareNoCase("ABC", "abc") == GLib::IcuUtils::CompareResult::Equal;
+				ok &= GLib::IcuUtils::CompareNoCase("\xC4\xB0", "i", "tr") == GLib::IcuUtils::CompareResult::Equal;
+				ok &= GLib::IcuUtils::ToUpper("i", "tr") == "\xC4\xB0";
+				ok &= GLib::IcuUtils::ToUpper("i") == "I";
+			}
+			return ok;
+		};
+
+		auto other = std::async(std::launch::async, compare);
+		BOOST_TEST(compare());
+		BOOST_TEST(other.get());
+	}
+
+	BOOST_AUTO_TEST_CASE(AsciiFastPathMatchesCollator)
+	{
+		const std::vector<std::string> values {"", " ", "a", "A", "b", "_", "-", ".", "1", "10", "9", "~", "a b", "a-b", "a_b", "ab", "aB", "AB", "abc",
+			"Abc", "a1", "a/b", "a\\b", "Z", "z", "[", "@", "ch", "c", "d", "aa", "\xC3\xA5"};
+
+		auto collator = GLib::IcuUtils::Detail::MakeCollator();
+		::ucol_setStrength(collator.get(), UCOL_SECONDARY);
+
+		for (const auto & v1 : values)
+		{
+			for (const auto & v2 : values)
+			{
+				UErrorCode error = U_ZERO_ERROR;
+				const int expected = ::ucol_strcollUTF8(collator.get(), v1.c_str(), -1, v2.c_str(), -1, &error);
+				BOOST_TEST(expected == static_cast<int>(GLib::IcuUtils::CompareNoCase(v1, v2)), v1 << " <=> " << v2);
+			}
+		}
+
+		BOOST_TEST(GLib::IcuUtils::Detail::DefaultAsciiCollation().caseFold == GLib::IcuUtils::CanFoldAscii("Some/Path_1.cpp"));
+		BOOST_TEST(!GLib::IcuUtils::CanFoldAscii("perch\xC3\xA9"));
+		BOOST_TEST(!GLib::IcuUtils::CanFoldAscii("tab\t"));
+		BOOST_TEST('a' == GLib::IcuUtils::ToLowerAscii('A'));
+		BOOST_TEST('@' == GLib::IcuUtils::ToLowerAscii('@'));
+		BOOST_TEST('[' == GLib::IcuUtils::ToLowerAscii('['));
+	}
+
+	BOOST_AUTO_TEST_CASE(AsciiFastPathNeedsPlainCollator)
+	{
+		auto collator = GLib::IcuUtils::Detail::MakeCollator();
+		::ucol_setStrength(collator.get(), UCOL_SECONDARY);
+		BOOST_TEST(GLib::IcuUtils::Detail::MakeAsciiCollation(*collator).perCharacter);
+
+		UErrorCode error = U_ZERO_ERROR;
+		::ucol_setAttribute(collator.get(), UCOL_ALTERNATE_HANDLING, UCOL_SHIFTED, &error);
+		BOOST_TEST(UCOL_EQUAL == ::ucol_strcollUTF8(collator.get(), "a-b", -1, "ab", -1, &error)); // punctuation ignored
+		const auto shifted = GLib::IcuUtils::Detail::MakeAsciiCollation(*collator);
+		BOOST_TEST(!shifted.perCharacter);
+		BOOST_TEST(!shifted.caseFold);
+
+		::ucol_setAttribute(collator.get(), UCOL_ALTERNATE_HANDLING, UCOL_NON_IGNORABLE, &error);
+		::ucol_setAttribute(collator.get(), UCOL_NUMERIC_COLLATION, UCOL_ON, &error);
+		BOOST_TEST(UCOL_GREATER == ::ucol_strcollUTF8(collator.get(), "a10", -1, "a9", -1, &error));
+		BOOST_TEST(!GLib::IcuUtils::Detail::MakeAsciiCollation(*collator).perCharacter);
+		BOOST_TEST(U_SUCCESS(error));
+	}
+
+	BOOST_AUTO_TEST_CASE(SortNoCaseMatchesNoCaseLess)
+	{
+		std::vector<std::string> values {"b", "A", "\xc3\xbc", "u", "V", "a_b", "a-b", "10", "9", "Z", "a", "\xc3\x9c", "", "abc", "ABD"};
+		std::vector<std::string> expected = values;
+		std::stable_sort(expected.begin(), expected.end(),
+										 [](const std::string & s1, const std::string & s2) { return GLib::IcuUtils::CompareNoCase(s1, s2) == GLib::IcuUtils::CompareResult::Less; });
+
+		GLib::IcuUtils::SortNoCase(values);
+		BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), values.begin(), values.end());
+
+		std::vector<std::string_view> views {"i", "\xC4\xB0", "h", "j"};
+		GLib::IcuUtils::SortNoCase(views, "tr");
+		BOOST_TEST(views == (std::vector<std::string_view> {"h", "i", "\xC4\xB0", "j"}));
+	}
+
+	BOOST_AUTO_TEST_CASE(SortKeyMap)
+	{
+		std::map<GLib::IcuUtils::SortKey, int> map;
+		map[GLib::IcuUtils::SortKey {"Beta"}] = 2;
+		map[GLib::IcuUtils::SortKey {"alpha"}] = 1;
+		map[GLib::IcuUtils::SortKey {"ALPHA"}] += 10;
+
+		BOOST_TEST(map.size() == 2U);
+		BOOST_TEST(map.begin()->second == 11);
+		BOOST_TEST(map.count(GLib::IcuUtils::SortKey {"bEtA"}) == 1U);
+		BOOST_TEST((GLib::IcuUtils::SortKey {"u"} < GLib::IcuUtils::SortKey {"\xc3\xbc"}));
+		BOOST_TEST((GLib::IcuUtils::SortKey {"\xc3\xbc"} < GLib::IcuUtils::SortKey {"v"}));
+		BOOST_TEST((GLib::IcuUtils::SortKey {std::string(1000, 'x')} == GLib::IcuUtils::SortKey {std::string(1000, 'X')}));
+	}
+
+	BOOST_AUTO_TEST_CASE(NfcNormalises)
+	{
+		BOOST_TEST("plain ascii" == GLib::IcuUtils::ToNfc("plain ascii"));
+		BOOST_TEST("caf\xC3\xA9" == GLib::IcuUtils::ToNfc("cafe\xCC\x81"));
+		BOOST_TEST("caf\xC3\xA9" == GLib::IcuUtils::ToNfc("caf\xC3\xA9"));
+		BOOST_TEST("\xE1\xBB\x87" == GLib::IcuUtils::ToNfc("e\xCC\xA3\xCC\x82")); // e, dot below, circumflex
+		BOOST_TEST("\xEA\xB0\x80" == GLib::IcuUtils::ToNfc("\xE1\x84\x80\xE1\x85\xA1")); // hangul jamo
+		GLIB_CHECK_RUNTIME_EXCEPTION(GLib::IcuUtils::ToNfc("ab\xC3"), "Truncated UTF-8 at offset 2");
+		GLIB_CHECK_RUNTIME_EXCEPTION(GLib::IcuUtils::ToNfc("abc\xFF"), "Invalid UTF-8 at offset 3");
+	}
+
+	BOOST_AUTO_TEST_CASE(NfcWriterChunks)
+	{
+		std::string value;
+		for (int i = 0; i < 50; ++i)
+		{
+			value += "<e a='cafe\xCC\x81'>x\xE2\x82\xAC e\xCC\xA3\xCC\x82</e>";
+		}
+		const std::string expected = GLib::IcuUtils::ToNfc(value);
+		BOOST_TEST(expected.find("\xCC") == std::string::npos);
+
+		for (size_t chunk : {1, 2, 3, 5, 64})
+		{
+			std::string actual;
+			GLib::IcuUtils::NfcWriter writer {actual};
+			for (size_t i = 0; i < value.size(); i += chunk)
+			{
+				writer.Write(std::string_view {value}.substr(i, chunk));
+			}
+			writer.Finish();
+			BOOST_TEST(expected == actual);
+		}
+
+		std::string xml;
+		GLib::IcuUtils::NfcWriter writer {xml};
+		writer.Write("<r\xC3\xA9sum");
+		writer.Write("e\xCC\x81/>");
+		writer.Finish();
+		GLib::Xml::Holder holder {xml};
+		BOOST_TEST((*holder.begin()).Name() == "r\xC3\xA9sum\xC3\xA9");
+	}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -1,5 +1,6 @@
 
 #include <GLib/NoCase.h>
+#include <GLib/NoCaseFlatMap.h>
 
 #include <boost/test/unit_test.hpp>
 
@@ -34,4 +35,89 @@ BOOST_AUTO_TEST_CASE(NoCaseHashChar)
 	BOOST_TEST(size_t{1} == set.size());
 }
 
+BOOST_AUTO_TEST_CASE(NoCaseHashAsciiMatchesIcu)
+{
+	GLib::NoCaseHash<char> hash;
+	BOOST_TEST(hash("Some/Path/File.CPP") == hash("some/path/file.cpp"));
+	BOOST_TEST(hash("PERCH\xC3\x89") == hash("perch\xC3\xA9"));
+	BOOST_TEST(hash("\xE2\x84\xAA") == hash("K")); // kelvin sign lowers to k
+
+	UnorderedCaseInsensitiveSet<char> set {"Path/A", "path/a", "PATH/B", "path/b", "Path/C"};
+	BOOST_TEST(size_t {3} == set.size());
+	BOOST_TEST(set.count("pAtH/c") == 1U);
+}
+
+BOOST_AUTO_TEST_CASE(NoCaseFlatMapFoldsKeys)
+{
+	GLib::NoCaseFlatMap<char, int> map;
+	map["Path/File.CPP"] += 1;
+	map["path/file.cpp"] += 2;
+	map["PERCH\xC3\x89"] += 3;
+	map["gro\xC3\x9F"] += 4;
+
+	BOOST_TEST(map.size() == 3U);
+	BOOST_TEST(map.count("GROSS") == 0U); // simple case folding as _wcsicmp, not full folding
+	BOOST_TEST(map.find("PATH/FILE.cpp")->first == "Path/File.CPP");
+	BOOST_TEST(map.find("PATH/FILE.cpp")->second == 3);
+	BOOST_TEST(map.find("perch\xC3\xA9")->second == 3);
+	BOOST_TEST(map.find("GRO\xE1\xBA\x9E")->second == 4); // capital sharp s
+	BOOST_TEST(map.count("path/file.h") == 0U);
+	BOOST_TEST((map.find("perche") == map.end()));
+
+	GLib::NoCaseFlatMap<char, int> kelvin {{"\xE2\x84\xAA", 1}};
+	BOOST_TEST(kelvin.count("k") == 1U); // kelvin sign folds to k
+
+	BOOST_TEST(!map.try_emplace("path/FILE.cpp", 0).second);
+	BOOST_TEST(map.try_emplace("path/file.h", 5).second);
+	BOOST_TEST(map.find("Path/File.H")->second == 5);
+}
+
+BOOST_AUTO_TEST_CASE(NoCaseFlatMapWide)
+{
+	GLib::NoCaseFlatMap<wchar_t, int> map;
+	map[L"C:\\Src\\A.cpp"] = 1;
+	map[L"C:\\Src\\\u00C9.cpp"] = 2;
+
+	BOOST_TEST(map.size() == 2U);
+	BOOST_TEST(map.find(L"c:\\src\\a.CPP")->second == 1);
+	BOOST_TEST(map.find(L"C:\\SRC\\\u00C9.CPP")->second == 2);
+	BOOST_TEST(map.count(L"c:\\src\\\u00E9.cpp") == 0U); // only A-Z fold, as _wcsicmp in the C locale
+	map[L"\u212A"] = 3; // kelvin sign is not folded to k
+	BOOST_TEST(map.size() == 3U);
+	BOOST_TEST(map.count(L"k") == 0U);
+	BOOST_TEST((map.find(L"c:\\src\\b.cpp") == map.end()));
+}
+
+BOOST_AUTO_TEST_CASE(NoCaseFlatMapGrowth)
+{
+	constexpr int count = 1000;
+	GLib::NoCaseFlatMap<char, int> map;
+	const int & first = map["Key0"];
+	for (int i = 0; i < count; ++i)
+	{
+		map["Key" + std::to_string(i)] = i;
+	}
+
+	BOOST_TEST(map.size() == static_cast<size_t>(count));
+	BOOST_TEST(&first == &map.find("KEY0")->second); // references are stable
+
+	int expected {};
+	for (const auto & [key, value] : map) // insertion order
+	{
+		BOOST_TEST(key == "Key" + std::to_string(expected));
+		BOOST_TEST(value == expected++);
+	}
+
+	for (int i = 0; i < count; ++i)
+	{
+		BOOST_TEST(map.find("kEY" + std::to_string(i))->second == i);
+	}
+
+	const GLib::NoCaseFlatMap<char, int> copy = map;
+	BOOST_TEST(copy.find("key999")->second == count - 1);
+	map.clear();
+	BOOST_TEST(map.empty());
+	BOOST_TEST((map.find("key1") == map.end()));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -0,0 +1,67 @@
+#include <GLib/PerfectHash.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+#include "TestUtils.h"
+
+using namespace GLib::Util;
+
+namespace
+{
+	constexpr auto colours = MakePerfectHashSet({"red", "green", "blue", "cyan", "magenta", "yellow", "black", "white"});
+	static_assert(colours.contains("cyan"));
+	static_assert(!colours.contains("Cyan"));
+
+	enum class Colour
+	{
+		Red,
+		Green,
+		Blue
+	};
+
+	constexpr auto colourValues = MakePerfectHashMap<Colour>({{"red", Colour::Red}, {"green", Colour::Green}, {"blue", Colour::Blue}});
+	static_assert(*colourValues.find("green") == Colour::Green);
+}
+
+BOOST_AUTO_TEST_SUITE(PerfectHashTests)
+
+BOOST_AUTO_TEST_CASE(Set)
+{
+	BOOST_TEST(colours.size() == 8U);
+	for (std::string_view colour : {"red", "green", "blue", "cyan", "magenta", "yellow", "black", "white"})
+	{
+		BOOST_TEST(colours.contains(colour));
+		BOOST_TEST(!colours.contains(std::string(colour) + "s"));
+		BOOST_TEST(!colours.contains(colour.substr(1)));
+	}
+	BOOST_TEST(!colours.contains(""));
+	BOOST_TEST(!colours.contains("orange"));
+}
+
+BOOST_AUTO_TEST_CASE(LongKeys)
+{
+	constexpr auto keys = MakePerfectHashSet({"reinterpret_cast", "reinterpret_casts", "static_assert", "thread_local", "a", ""});
+	BOOST_TEST(keys.contains("reinterpret_cast"));
+	BOOST_TEST(keys.contains("reinterpret_casts"));
+	BOOST_TEST(keys.contains(""));
+	BOOST_TEST(!keys.contains("reinterpret_cas"));
+	BOOST_TEST(!keys.contains("static_asserts"));
+}
+
+BOOST_AUTO_TEST_CASE(Map)
+{
+	BOOST_TEST(colourValues.size() == 3U);
+	BOOST_TEST((*colourValues.find("red") == Colour::Red));
+	BOOST_TEST((*colourValues.find("blue") == Colour::Blue));
+	BOOST_TEST(colourValues.find("cyan") == nullptr);
+	BOOST_TEST(!colourValues.contains("Red"));
+}
+
+BOOST_AUTO_TEST_CASE(Duplicate)
+{
+	GLIB_CHECK_LOGIC_EXCEPTION((void) MakePerfectHashSet({"red", "green", "red"}), "Duplicate key");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -3,6 +3,11 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <vector>
+
 BOOST_AUTO_TEST_SUITE(ScopeTests)
 
 BOOST_AUTO_TEST_CASE(SimpleTest)
@@ -26,4 +31,56 @@ BOOST_AUTO_TEST_CASE(TwoScopes)
 	BOOST_TEST(3 == deScoped);
 }
 
+BOOST_AUTO_TEST_CASE(StackRunsInReverse)
+{
+	std::vector<int> order;
+	{
+		GLib::ScopeStack<> scope;
+		for (int i = 0; i < 100; ++i)
+		{
+			scope.Push([&order, i]() noexcept { order.push_back(i); });
+		}
+		BOOST_TEST(scope.Size() == 100U);
+		BOOST_TEST(order.empty());
+	}
+	BOOST_TEST(order.size() == 100U);
+	BOOST_TEST(std::is_sorted(order.rbegin(), order.rend()));
+}
+
+BOOST_AUTO_TEST_CASE(StackLargeFunctions)
+{
+	std::array<char, 1000> large {};
+	large.back() = 1;
+	int total = 0;
+	{
+		GLib::ScopeStack<2> scope;
+		scope.Push([&total, large]() noexcept { total += large.back(); });
+		scope.Push([&total]() noexcept { total += 10; });
+		scope.Push([&total, large]() noexcept { total += large.back() * 100; });
+	}
+	BOOST_TEST(total == 111);
+}
+
+BOOST_AUTO_TEST_CASE(StackDismissAndRun)
+{
+	int count = 0;
+	GLib::ScopeStack<> scope;
+	scope.Push([&]() noexcept { ++count; });
+	scope.Push([&]() noexcept { ++count; });
+	scope.Dismiss();
+	BOOST_TEST(scope.Size() == 0U);
+
+	auto shared = std::make_shared<int>();
+	scope.Push([&, shared]() noexcept { count += 10; });
+	BOOST_TEST(shared.use_count() == 2);
+	scope.Run();
+	BOOST_TEST(count == 10);
+	BOOST_TEST(shared.use_count() == 1);
+
+	scope.Push([&, shared]() noexcept { ++count; });
+	scope.Dismiss();
+	BOOST_TEST(count == 10);
+	BOOST_TEST(shared.use_count() == 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
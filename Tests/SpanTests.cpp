@@ -0,0 +1,91 @@
+#include <GLib/Span.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+	bool IsIndexOutOfRange(const std::logic_error & e) { return e.what() == std::string("IndexOutOfRange"); }
+	bool IsSliceOutOfRange(const std::logic_error & e) { return e.what() == std::string("SliceOutOfRange"); }
+}
+
+BOOST_AUTO_TEST_SUITE(SpanTests)
+
+BOOST_AUTO_TEST_CASE(Empty)
+{
+	constexpr GLib::Span<int> span;
+	static_assert(span.empty());
+	static_assert(span.begin() == span.end());
+	BOOST_TEST(span.size() == 0);
+	BOOST_CHECK_EXCEPTION((void) span.at(0), std::logic_error, IsIndexOutOfRange);
+}
+
+BOOST_AUTO_TEST_CASE(Iterators)
+{
+	static_assert(std::is_same_v<GLib::Span<int>::iterator, const int *>);
+	static_assert(std::is_same_v<GLib::MutableSpan<int>::iterator, int *>);
+
+	const std::vector<int> values {1, 2, 3, 4, 5};
+	const auto span = GLib::MakeSpan(values.data(), values.size());
+	BOOST_TEST(span.size() == 5);
+	BOOST_TEST(std::accumulate(span.begin(), span.end(), 0) == 15);
+	BOOST_TEST(span.end() - span.begin() == 5);
+	BOOST_TEST(std::vector<int>(span.rbegin(), span.rend()) == (std::vector<int> {5, 4, 3, 2, 1}));
+
+	int sum {};
+	for (int value : span)
+	{
+		sum += value;
+	}
+	BOOST_TEST(sum == 15);
+}
+
+BOOST_AUTO_TEST_CASE(Access)
+{
+	const std::array<int, 3> values {1, 2, 3};
+	const auto span = GLib::MakeSpan(values.data(), values.size());
+	BOOST_TEST(span[0] == 1);
+	BOOST_TEST(span.at(2) == 3);
+	BOOST_CHECK_EXCEPTION((void) span.at(3), std::logic_error, IsIndexOutOfRange);
+	BOOST_CHECK_EXCEPTION((void) span.at(-1), std::logic_error, IsIndexOutOfRange);
+}
+
+BOOST_AUTO_TEST_CASE(Slices)
+{
+	const std::vector<int> values {1, 2, 3, 4, 5};
+	const auto span = GLib::MakeSpan(values.data(), values.size());
+
+	BOOST_TEST(std::vector<int>(span.first(2).begin(), span.first(2).end()) == (std::vector<int> {1, 2}));
+	BOOST_TEST(std::vector<int>(span.last(2).begin(), span.last(2).end()) == (std::vector<int> {4, 5}));
+	BOOST_TEST(std::vector<int>(span.subspan(1, 3).begin(), span.subspan(1, 3).end()) == (std::vector<int> {2, 3, 4}));
+	BOOST_TEST(span.subspan(3).size() == 2);
+	BOOST_TEST(span.subspan(5).empty());
+	BOOST_TEST(span.first(0).empty());
+
+	BOOST_CHECK_EXCEPTION((void) span.first(6), std::logic_error, IsSliceOutOfRange);
+	BOOST_CHECK_EXCEPTION((void) span.last(6), std::logic_error, IsSliceOutOfRange);
+	BOOST_CHECK_EXCEPTION((void) span.subspan(6), std::logic_error, IsSliceOutOfRange);
+	BOOST_CHECK_EXCEPTION((void) span.subspan(2, 4), std::logic_error, IsSliceOutOfRange);
+	BOOST_CHECK_EXCEPTION((void) span.subspan(-1, 1), std::logic_error, IsSliceOutOfRange);
+}
+
+BOOST_AUTO_TEST_CASE(Mutable)
+{
+	std::vector<int> values(5);
+	const auto span = GLib::MakeMutableSpan(values.data(), values.size());
+	std::iota(span.begin(), span.end(), 1);
+	span[0] = 10;
+	std::fill(span.subspan(3).begin(), span.subspan(3).end(), 0);
+	BOOST_TEST(values == (std::vector<int> {10, 2, 3, 0, 0}));
+
+	const GLib::Span<int> readOnly = span;
+	BOOST_TEST(readOnly.data() == values.data());
+	BOOST_TEST(readOnly.size() == 5);
+	static_assert(!std::is_convertible_v<GLib::Span<int>, GLib::MutableSpan<int>>);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
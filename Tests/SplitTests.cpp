@@ -1,12 +1,19 @@
 
 
 #include <GLib/split.h>
+#include <GLib/ParallelSplit.h>
 
 #include <GLib/ConsecutiveFind.h>
 #include <GLib/cvt.h>
 
 #include <boost/test/unit_test.hpp>
 
+#include <atomic>
+#include <cctype>
+#include <mutex>
+#include <set>
+#include <thread>
+
 #include "TestUtils.h"
 
 BOOST_AUTO_TEST_SUITE(SplitTests)
@@ -30,13 +37,35 @@ BOOST_AUTO_TEST_CASE(TestFor)
 	std::vector<std::string> result;
 	for (const auto & value : GLib::Util::Splitter("a<->bc<->def<->ghijkl", "<->"))
 	{
-		result.push_back(value);
+		result.emplace_back(value);
 	}
 
 	std::vector<std::string> expected { "a", "bc", "def", "ghijkl" };
 	BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), result.begin(), result.end());
 }
 
+BOOST_AUTO_TEST_CASE(TestNonOwning)
+{
+	const std::string value = "a.bc.def";
+	GLib::Util::Splitter s(GLib::Util::NonOwning, value, ".");
+	std::vector<std::string> expected { "a", "bc", "def" };
+	BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), s.begin(), s.end());
+
+	auto it = s.begin();
+	BOOST_TEST((*it).data() == value.data());
+	BOOST_TEST((*++it).data() == value.data() + 2);
+}
+
+BOOST_AUTO_TEST_CASE(TestOwningCopy)
+{
+	GLib::Util::Splitter s(std::string("a,b"));
+	GLib::Util::Splitter copy = s;
+	GLib::Util::Splitter moved = std::move(s);
+	std::vector<std::string> expected { "a", "b" };
+	BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), copy.begin(), copy.end());
+	BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), moved.begin(), moved.end());
+}
+
 BOOST_AUTO_TEST_CASE(TestEmptyString)
 {
 	GLib::Util::Splitter s("");
@@ -120,6 +149,130 @@ BOOST_AUTO_TEST_CASE(EmptyDeliminatorIsError)
 	GLIB_CHECK_LOGIC_EXCEPTION({ GLib::Util::Split(value, std::back_inserter(actual), {}); }, "Delimiter is empty");
 }
 
+BOOST_AUTO_TEST_CASE(ByteSetMatchesPredicate)
+{
+	auto identifier = [](unsigned char c) { return std::isalnum(c) != 0 || c == '_'; };
+	auto whitespace = [](unsigned char c) { return std::isspace(c) != 0; };
+
+	std::string value;
+	for (unsigned int i = 0; i < 1000; ++i)
+	{
+		value += static_cast<char>((i * 7919U) % 256U);
+	}
+
+	for (size_t pos = 0; pos < value.size(); ++pos)
+	{
+		const auto & id = GLib::Util::ByteSets::Identifier();
+		const auto & ws = GLib::Util::ByteSets::WhiteSpace();
+
+		auto expected = std::find_if(value.begin() + pos, value.end(), identifier) - value.begin();
+		BOOST_TEST(static_cast<size_t>(expected) == std::min(GLib::Util::FindFirstOf(value, id, pos), value.size()));
+
+		expected = std::find_if_not(value.begin() + pos, value.end(), identifier) - value.begin();
+		BOOST_TEST(static_cast<size_t>(expected) == std::min(GLib::Util::FindFirstNotOf(value, id, pos), value.size()));
+
+		expected = std::find_if(value.begin() + pos, value.end(), whitespace) - value.begin();
+		BOOST_TEST(static_cast<size_t>(expected) == std::min(GLib::Util::FindFirstOf(value, ws, pos), value.size()));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(ByteSetRanges)
+{
+	const GLib::Util::ByteSet high {{0x80, 0xFF}};
+	const std::string value = std::string(40, 'a') + "\xC2\xA3" + std::string(40, 'b');
+	BOOST_TEST(40U == GLib::Util::FindFirstOf(value, high));
+	BOOST_TEST(42U == GLib::Util::FindFirstNotOf(value, high, 40));
+	BOOST_TEST(std::string::npos == GLib::Util::FindFirstOf(value, high, 42));
+
+	const GLib::Util::ByteSet all {{0x00, 0xFF}};
+	BOOST_TEST(std::string::npos == GLib::Util::FindFirstNotOf(value, all));
+
+	const GLib::Util::ByteSet bytes {"\n\t,;\"b"};
+	BOOST_TEST(5U == bytes.RangeCount());
+	BOOST_TEST(bytes.Contains('\t'));
+	BOOST_TEST(!bytes.Contains('a'));
+	BOOST_TEST(42U == GLib::Util::FindFirstOf(value, bytes, 40));
+
+	GLIB_CHECK_LOGIC_EXCEPTION(GLib::Util::ByteSet {"acegikmoq"}, "Too many ranges");
+	GLIB_CHECK_LOGIC_EXCEPTION((GLib::Util::ByteSet {{'z', 'a'}}), "Invalid range");
+}
+
+BOOST_AUTO_TEST_CASE(SplitByteSet)
+{
+	const std::string value = "  int main(int argc, char * argv[])\n{\n\treturn 0;\n}  ";
+	std::vector<std::pair<bool, std::string_view>> expected, actual;
+
+	GLib::Util::Split(value, [](unsigned char c) { return std::isalnum(c) != 0 || c == '_'; },
+		[&](std::string_view v) { expected.emplace_back(true, v); }, [&](std::string_view v) { expected.emplace_back(false, v); });
+	GLib::Util::Split(value, GLib::Util::ByteSets::Identifier(),
+		[&](std::string_view v) { actual.emplace_back(true, v); }, [&](std::string_view v) { actual.emplace_back(false, v); });
+
+	BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), actual.begin(), actual.end());
+}
+
+BOOST_AUTO_TEST_CASE(ParallelSplitMatchesSequential)
+{
+	std::string value;
+	for (int i = 0; i < 1000; ++i)
+	{
+		value += std::string(static_cast<size_t>(i % 37), 'x') + (i % 5 == 0 ? "\r\n\r\n" : "\r\n");
+	}
+
+	for (std::string_view delimiter : {"\n", "\r\n", "x", "aa", "missing"})
+	{
+		std::vector<std::string_view> expected;
+		for (auto token : GLib::Util::SplitterView {GLib::Util::NonOwning, value, delimiter})
+		{
+			expected.push_back(token);
+		}
+
+		for (size_t chunkCount : {0, 1, 2, 7, 64, 100000})
+		{
+			std::vector<std::string_view> actual;
+			for (const auto & chunk : GLib::Util::ParallelSplit(value, delimiter, chunkCount))
+			{
+				actual.insert(actual.end(), chunk.begin(), chunk.end());
+			}
+			BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), actual.begin(), actual.end());
+		}
+	}
+
+	BOOST_TEST(GLib::Util::ParallelSplit("", "\n", 4) == (std::vector<std::vector<std::string_view>> {{""}}));
+	BOOST_TEST(GLib::Util::ParallelSplit("aaa", "aa", 3) == (std::vector<std::vector<std::string_view>> {{"", "a"}}));
+	GLIB_CHECK_LOGIC_EXCEPTION(GLib::Util::ParallelSplit("a", ""), "Delimiter is empty");
+}
+
+BOOST_AUTO_TEST_CASE(ParallelSplitEach)
+{
+	const std::string value = "1\n2\n3\n4\n5\n6\n7\n8";
+	std::array<std::atomic<int>, 4> sums {};
+	std::atomic<int> total {};
+	GLib::Util::ParallelSplitEach(value, "\n", [&](size_t index, std::string_view token)
+	{
+		sums.at(index) += std::stoi(std::string {token});
+		total += std::stoi(std::string {token});
+	}, 4);
+	BOOST_TEST(36 == total);
+	BOOST_TEST(3 == sums[0]);
+
+	std::mutex mutex;
+	std::set<std::thread::id> threads;
+	GLib::Util::ParallelSplitEach(std::string(100000, ','), ",", [&](size_t /*index*/, std::string_view /*token*/)
+	{
+		const std::lock_guard<std::mutex> lock(mutex);
+		threads.insert(std::this_thread::get_id());
+	}, 100000);
+	BOOST_TEST(threads.size() <= std::max(std::thread::hardware_concurrency(), 1U)); // not a thread per chunk
+
+	GLIB_CHECK_RUNTIME_EXCEPTION(GLib::Util::ParallelSplitEach(value, "\n", [](size_t index, std::string_view)
+	{
+		if (index == 2)
+		{
+			throw std::runtime_error("Chunk failed");
+		}
+	}, 4), "Chunk failed");
+}
+
 BOOST_AUTO_TEST_CASE(ConsecutiveFindTest)
 {
 	std::vector<int> values { 1,1,2,3,3,3};
@@ -3,6 +3,9 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <string>
+#include <string_view>
+
 namespace
 {
 	constexpr size_t operator "" _size(unsigned long long int n ) { return static_cast<size_t>(n); }
@@ -60,4 +63,82 @@ BOOST_AUTO_TEST_CASE(Const)
 	BOOST_TEST(nullptr != s.Get());
 }
 
+BOOST_AUTO_TEST_CASE(GrowKeepsContents)
+{
+	GLib::Util::StackOrHeap<char, 4_size> s;
+	std::copy_n("abcd", 4, s.Get());
+
+	s.EnsureSizeKeepingContents(8_size);
+	BOOST_TEST(std::string(s.Get(), 4) == "abcd");
+
+	s.Shrink(3_size);
+	BOOST_CHECK(4_size == s.size());
+	BOOST_TEST(std::string(s.Get(), 3) == "abc");
+}
+
+BOOST_AUTO_TEST_CASE(Move)
+{
+	GLib::Util::StackOrHeap<char, 4_size> s;
+	s.EnsureSize(8_size);
+	const char * p = s.Get();
+
+	GLib::Util::StackOrHeap<char, 4_size> moved = std::move(s);
+	BOOST_TEST(p == moved.Get());
+	BOOST_CHECK(8_size == moved.size());
+	BOOST_CHECK(4_size == s.size()); // NOLINT(bugprone-use-after-move,hicpp-invalid-access-moved) reset to stack
+
+	s = std::move(moved);
+	BOOST_TEST(p == s.Get());
+}
+
+BOOST_AUTO_TEST_CASE(SmallVector)
+{
+	GLib::Util::SmallVector<char, 8_size> v;
+	const char * stack = v.data();
+	BOOST_TEST(v.empty());
+
+	v.append(std::string_view {"abcdef"});
+	v.push_back('g');
+	BOOST_TEST(stack == v.data());
+	BOOST_CHECK(8_size == v.capacity());
+
+	v.append(std::string {"hijk"});
+	BOOST_TEST(stack != v.data());
+	BOOST_CHECK(16_size == v.capacity()); // doubled
+	BOOST_TEST(std::string(v.begin(), v.end()) == "abcdefghijk");
+
+	v.resize(3_size);
+	v.shrink_to_fit();
+	BOOST_TEST(stack == v.data());
+	BOOST_TEST(std::string(v.begin(), v.end()) == "abc");
+
+	v.resize(20_size);
+	BOOST_TEST(v[19] == '\0');
+
+	GLib::Util::SmallVector<char, 8_size> moved = std::move(v);
+	BOOST_CHECK(20_size == moved.size());
+	BOOST_TEST(v.empty()); // NOLINT(bugprone-use-after-move,hicpp-invalid-access-moved) reset
+	BOOST_TEST(std::string(moved.begin(), moved.begin() + 3) == "abc");
+}
+
+BOOST_AUTO_TEST_CASE(SmallVectorAppendSelf)
+{
+	GLib::Util::SmallVector<std::string, 4_size> v;
+	v.push_back("a");
+	v.push_back("b");
+	v.push_back("c");
+
+	v.append(v.data(), v.size()); // stack to heap
+	BOOST_CHECK(6_size == v.size());
+	v.append(v.data() + 1, 5_size); // heap to larger heap
+	BOOST_CHECK(11_size == v.size());
+
+	std::string joined;
+	for (const auto & value : v)
+	{
+		joined += value;
+	}
+	BOOST_TEST(joined == "abcabcbcabc");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include <GLib/genericoutstream.h>
+#include <GLib/spanstreambuffer.h>
+#include <GLib/vectorstreambuffer.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <array>
+#include <string>
+#include <vector>
+
+namespace
+{
+	constexpr size_t DefaultCapacity = 16;
+	using Buffer = GLib::Util::VectorStreamBuffer<char, DefaultCapacity>;
+	using Stream = GLib::Util::GenericOutStream<char, Buffer>;
+}
+
+BOOST_AUTO_TEST_SUITE(StreamBufferTests)
+
+BOOST_AUTO_TEST_CASE(PutAreaGrows)
+{
+	Stream stream;
+	stream.Stream() << "abc" << 123 << 'x';
+	BOOST_TEST(stream.Buffer().Get() == "abc123x");
+	BOOST_TEST(stream.Buffer().Capacity() == DefaultCapacity);
+
+	const std::string large(100, '-');
+	stream.Stream() << large;
+	BOOST_TEST(stream.Buffer().Get() == "abc123x" + large);
+	BOOST_TEST(stream.Buffer().Capacity() >= 107U);
+
+	stream.Buffer().Reset();
+	BOOST_TEST(stream.Buffer().Get().empty());
+	stream.Stream() << "def";
+	BOOST_TEST(stream.Buffer().Get() == "def");
+}
+
+BOOST_AUTO_TEST_CASE(CapacityDecays)
+{
+	Stream stream;
+	stream.Stream() << std::string(DefaultCapacity * 100, '-');
+	stream.Buffer().Reset();
+	const size_t large = stream.Buffer().Capacity();
+
+	// kept while small messages follow, then released
+	for (int i = 0; i < 7; ++i)
+	{
+		stream.Stream() << "small";
+		stream.Buffer().Reset();
+		BOOST_TEST(stream.Buffer().Capacity() == large);
+	}
+	stream.Stream() << "small";
+	stream.Buffer().Reset();
+	BOOST_TEST(stream.Buffer().Capacity() == DefaultCapacity);
+
+	stream.Stream() << "after";
+	BOOST_TEST(stream.Buffer().Get() == "after");
+}
+
+BOOST_AUTO_TEST_CASE(Take)
+{
+	Stream stream;
+	stream.Stream() << std::string(100, 'a');
+	const char * data = stream.Buffer().Get().data();
+
+	std::vector<char> taken = stream.Buffer().Take();
+	BOOST_TEST(static_cast<const void *>(taken.data()) == static_cast<const void *>(data)); // not copied
+	BOOST_TEST(std::string(taken.begin(), taken.end()) == std::string(100, 'a'));
+	BOOST_TEST(stream.Buffer().Get().empty());
+
+	stream.Stream() << "next";
+	BOOST_TEST(stream.Buffer().Get() == "next");
+}
+
+BOOST_AUTO_TEST_CASE(SpanStreamBufferTruncates)
+{
+	std::array<char, 8> storage {};
+	GLib::Util::GenericOutStream<char, GLib::Util::SpanStreamBuffer<char>> stream {{}, storage.data(), storage.size()};
+	stream.Stream() << "abc" << 12;
+	BOOST_TEST(stream.Buffer().Get() == "abc12");
+	BOOST_TEST(!stream.Buffer().Truncated());
+	BOOST_TEST(stream.Stream().good());
+
+	stream.Stream() << "defgh";
+	BOOST_TEST(stream.Buffer().Get() == "abc12def");
+	BOOST_TEST(stream.Buffer().Truncated());
+	BOOST_TEST(stream.Stream().bad());
+
+	stream.Buffer().Reset();
+	stream.Stream().clear();
+	stream.Stream() << 'x';
+	BOOST_TEST(stream.Buffer().Get() == "x");
+	BOOST_TEST(stream.Buffer().Capacity() == storage.size());
+}
+
+BOOST_AUTO_TEST_CASE(SpanWriter)
+{
+	char storage[64]; // NOLINT(cppcoreguidelines-avoid-c-arrays,hicpp-avoid-c-arrays,modernize-avoid-c-arrays)
+	GLib::Util::SpanWriter writer {storage};
+	writer << "value " << 42 << ' ' << -7L << ' ' << 2.5 << ' ' << true << ' ' << std::string_view {"end"};
+	BOOST_TEST(writer.Get() == "value 42 -7 2.5 1 end");
+	BOOST_TEST(!writer.Truncated());
+
+	writer.Reset();
+	writer << reinterpret_cast<const void *>(0x1234); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast,performance-no-int-to-ptr) test value
+	BOOST_TEST(writer.Get() == "0x1234");
+
+	char small[4]; // NOLINT(cppcoreguidelines-avoid-c-arrays,hicpp-avoid-c-arrays,modernize-avoid-c-arrays)
+	GLib::Util::SpanWriter bounded {small};
+	bounded << "ab" << 12345;
+	BOOST_TEST(bounded.Get() == "ab12");
+	BOOST_TEST(bounded.Truncated());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,4 +1,5 @@
 
+#include <GLib/Arena.h>
 #include <GLib/Html/TemplateEngine.h>
 
 #include <boost/test/unit_test.hpp>
@@ -65,6 +66,36 @@ BOOST_AUTO_TEST_CASE(SimpleProperty)
 		BOOST_TEST(stm.str() == expected);
 	}
 
+	BOOST_AUTO_TEST_CASE(ForEachArena)
+	{
+		const std::vector<User> users
+		{
+			{ "Fred", 42, { "FC00"} }, { "Jim", 43, { "FD00"} }
+		};
+		Evaluator evaluator;
+		evaluator.SetCollection("users", users);
+
+		auto xml = R"(<xml xmlns:gl='glib'>
+<gl:block each="user : ${users}">
+	<User name='${user.name}' />
+</gl:block>
+</xml>)";
+
+		GLib::Util::Arena arena;
+		GLib::Util::ArenaResource resource {arena};
+		std::ostringstream stm;
+		Generate(evaluator, xml, stm, &resource);
+		arena.Reset();
+
+	auto expected= R"(<xml>
+	<User name='Fred' />
+	<User name='Jim' />
+</xml>)";
+
+		BOOST_TEST(stm.str() == expected);
+		BOOST_TEST(arena.Capacity() != 0U);
+	}
+
 	BOOST_AUTO_TEST_CASE(NestedForEach)
 	{
 		const std::vector<User> users
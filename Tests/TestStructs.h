@@ -36,33 +36,26 @@ struct HasNoToString
 template <>
 struct GLib::Eval::Visitor<User>
 {
-	static void Visit(const User & user, const std::string & propertyName, const ValueVisitor & f)
+	static void Visit(const User & user, std::string_view propertyName, const ValueVisitor & f)
 	{
-		if (propertyName == "name")
-		{
-			return f(Value(user.name));
-		}
-		if (propertyName == "age")
-		{
-			return f(Value(user.age));
-		}
-		if (propertyName == "hobbies")
-		{
-			return f(MakeCollection(user.hobbies));
-		}
-		throw std::runtime_error(std::string("Unknown property : '") + propertyName + '\''); // bool return?
+		static constexpr auto properties = MakePropertyTable<User>({
+			{"name", [](const User & u, const ValueVisitor & visitor) { visitor(Value(u.name)); }},
+			{"age", [](const User & u, const ValueVisitor & visitor) { visitor(Value(u.age)); }},
+			{"hobbies", [](const User & u, const ValueVisitor & visitor) { visitor(MakeCollection(u.hobbies)); }},
+		});
+		properties.Visit(user, propertyName, f);
 	}
 };
 
 template <>
 struct GLib::Eval::Visitor<Struct>
 {
-	static void Visit(const Struct & value, const std::string & propertyName, const ValueVisitor & f)
+	static void Visit(const Struct & value, std::string_view propertyName, const ValueVisitor & f)
 	{
 		if (propertyName == "Nested")
 		{
 			return f(Value(value.Nested.value));
 		}
-		throw std::runtime_error(std::string("Unknown property : '") + propertyName + '\''); // bool return?
+		throw std::runtime_error("Unknown property : '" + std::string {propertyName} + '\''); // bool return?
 	}
 };
\ No newline at end of file
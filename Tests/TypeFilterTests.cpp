@@ -122,4 +122,26 @@ BOOST_AUTO_TEST_CASE(TestSelfFilter)
 	BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), actual.begin(), actual.end());
 }
 
+BOOST_AUTO_TEST_CASE(TestDispatch)
+{
+	using Dispatch = GLib::Util::TypeDispatch<GLib::Util::TypeFilter<std::is_integral, char, float, short, double, long long>::TupleType>;
+	static_assert(Dispatch::Size == 3);
+	static_assert(Dispatch::IndexOf<short>() == 1);
+	static_assert(Dispatch::IndexOf<float>() == Dispatch::Size);
+
+	auto size = [](auto tag) { return sizeof(typename decltype(tag)::Type); };
+	BOOST_TEST(Dispatch::Visit(0, size) == sizeof(char));
+	BOOST_TEST(Dispatch::Visit(1, size) == sizeof(short));
+	BOOST_TEST(Dispatch::Visit(2, size) == sizeof(long long));
+	BOOST_CHECK_THROW(Dispatch::Visit(3, size), std::logic_error);
+
+	std::list<std::type_index> actual;
+	for (size_t i = 0; i < Dispatch::Size; ++i)
+	{
+		Dispatch::Visit(i, [&](auto tag) { actual.emplace_back(typeid(typename decltype(tag)::Type)); });
+	}
+	std::list<std::type_index> expected { typeid(char), typeid(short), typeid(long long) };
+	BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), actual.begin(), actual.end());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
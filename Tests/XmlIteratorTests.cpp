@@ -1,4 +1,5 @@
 
+#include <GLib/Arena.h>
 #include <GLib/Xml/Printer.h>
 
 #include <boost/test/unit_test.hpp>
@@ -222,6 +223,25 @@ BOOST_AUTO_TEST_CASE(NameSpace2)
 	BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), xml.begin(), xml.end());
 }
 
+BOOST_AUTO_TEST_CASE(ArenaResource)
+{
+	Util::Arena arena;
+	Util::ArenaResource resource {arena};
+	Xml::Holder xml {R"(<foo:x xmlns:foo='foo-ns'>
+	<bar:y xmlns:bar='bar-ns' foo:at='f' bar:at='b'/>
+</foo:x>
+)", &resource};
+
+	std::vector<Xml::Element> expected
+	{
+		{"foo:x", "x", "foo-ns", Xml::ElementType::Open, {}},
+		{"bar:y", "y", "bar-ns", Xml::ElementType::Empty, { "xmlns:bar='bar-ns' foo:at='f' bar:at='b'" }},
+		{"foo:x", "x", "foo-ns", Xml::ElementType::Close, {}},
+	};
+	BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), xml.begin(), xml.end());
+	BOOST_TEST(arena.Capacity() != 0U);
+}
+
 BOOST_AUTO_TEST_CASE(NamespaceRedefine)
 {
 	Xml::Holder xml{ R"(<foo:x xmlns:foo='foo-ns' xmlns:bar='bar-ns'>
@@ -512,6 +532,13 @@ BOOST_AUTO_TEST_CASE(ElementTextEntities)
 	BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), xml.begin(), xml.end());
 }
 
+BOOST_AUTO_TEST_CASE(UnescapeEntities)
+{
+	std::ostringstream s;
+	Xml::Utils::Unescape("&amp; &lt; &gt; &apos; &quot; &#x20ac; &unknown; & &&lt; a&b", s);
+	BOOST_TEST(s.str() == "& < > \' \" &#x20ac; &unknown; & &< a&b");
+}
+
 BOOST_AUTO_TEST_CASE(AttributeEntities)
 {
 	Xml::Holder xml = { "<xml attr='&lt;'/>" };
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <vector>
+
+namespace GLib::Util
+{
+	// monotonic bump allocator for transient data, e.g. the containers of one parse or format
+	// nothing is freed individually, Reset makes all the memory available again keeping the blocks for the next use
+	class Arena
+	{
+	public:
+		static constexpr size_t DefaultBlockSize = 64 * 1024;
+
+	private:
+		struct Block
+		{
+			std::unique_ptr<std::byte[]> data; // NOLINT(cppcoreguidelines-avoid-c-arrays,hicpp-avoid-c-arrays,modernize-avoid-c-arrays)
+			size_t size;
+		};
+
+		std::vector<Block> blocks;
+		size_t blockIndex {};
+		size_t used {};
+		size_t const blockSize;
+
+	public:
+		explicit Arena(size_t blockSize = DefaultBlockSize)
+			: blockSize(blockSize)
+		{
+			if (blockSize == 0)
+			{
+				throw std::logic_error("Block size is zero");
+			}
+		}
+
+		Arena(const Arena &) = delete;
+		Arena & operator=(const Arena &) = delete;
+		Arena(Arena &&) = delete;
+		Arena & operator=(Arena &&) = delete;
+		~Arena() = default;
+
+		void * Allocate(size_t size, size_t alignment = alignof(std::max_align_t))
+		{
+			if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+			{
+				throw std::logic_error("Alignment is not a power of two");
+			}
+
+			for (;; ++blockIndex, used = 0)
+			{
+				if (blockIndex == blocks.size())
+				{
+					const size_t newBlockSize = std::max(blockSize, size + alignment);
+					blocks.push_back({std::make_unique<std::byte[]>(newBlockSize), newBlockSize}); // NOLINT(cppcoreguidelines-avoid-c-arrays,hicpp-avoid-c-arrays,modernize-avoid-c-arrays)
+				}
+
+				Block & block = blocks[blockIndex];
+				void * p = block.data.get() + used; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) used <= size
+				size_t space = block.size - used;
+				if (std::align(alignment, size, p, space) != nullptr)
+				{
+					used = block.size - space + size;
+					return p;
+				}
+			}
+		}
+
+		// all allocations are invalidated, the blocks are kept
+		void Reset() noexcept
+		{
+			blockIndex = 0;
+			used = 0;
+		}
+
+		// all allocations are invalidated and the blocks freed
+		void Release() noexcept
+		{
+			blocks.clear();
+			Reset();
+		}
+
+		size_t Capacity() const noexcept
+		{
+			size_t total {};
+			for (const auto & block : blocks)
+			{
+				total += block.size;
+			}
+			return total;
+		}
+	};
+
+	// std::pmr adaptor, deallocation does nothing as memory is returned by Arena::Reset
+	class ArenaResource : public std::pmr::memory_resource
+	{
+		Arena & arena;
+
+	public:
+		explicit ArenaResource(Arena & arena)
+			: arena(arena)
+		{}
+
+		Arena & Get() const noexcept
+		{
+			return arena;
+		}
+
+	protected:
+		void * do_allocate(size_t bytes, size_t alignment) override
+		{
+			return arena.Allocate(bytes, alignment);
+		}
+
+		void do_deallocate(void * p, size_t bytes, size_t alignment) override
+		{
+			(void) p;
+			(void) bytes;
+			(void) alignment;
+		}
+
+		bool do_is_equal(const std::pmr::memory_resource & other) const noexcept override
+		{
+			return this == &other;
+		}
+	};
+
+	// per thread default, the owner of each unit of work (request, parse, log line) calls Reset when it is done
+	inline Arena & ThreadArena()
+	{
+		thread_local Arena arena;
+		return arena;
+	}
+
+	inline ArenaResource & ThreadArenaResource()
+	{
+		thread_local ArenaResource resource {ThreadArena()};
+		return resource;
+	}
+}
@@ -0,0 +1,233 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <string_view>
+
+#if defined(__AVX2__)
+#define GLIB_BYTESET_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GLIB_BYTESET_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace GLib::Util
+{
+	// set of byte values described by up to MaxRanges inclusive ranges, e.g. identifier, whitespace or delimiter classes
+	// scans are vectorised with a biased signed compare per range: byte - first + INT8_MIN <= last - first + INT8_MIN
+	class ByteSet
+	{
+	public:
+		static constexpr size_t MaxRanges = 8;
+		static constexpr size_t ByteCount = 256;
+
+		struct Range
+		{
+			unsigned char first;
+			unsigned char last;
+		};
+
+	private:
+		static constexpr int SignBias = 0x80;
+
+		std::array<char, MaxRanges> bias {};
+		std::array<char, MaxRanges> limit {};
+		size_t rangeCount {};
+		std::array<bool, ByteCount> table {};
+
+	public:
+		ByteSet(std::initializer_list<Range> ranges)
+		{
+			if (ranges.size() > MaxRanges)
+			{
+				throw std::logic_error("Too many ranges");
+			}
+
+			for (const auto & range : ranges)
+			{
+				Add(range);
+			}
+		}
+
+		// individual bytes, adjacent values are merged into one range
+		explicit ByteSet(std::string_view bytes)
+		{
+			std::array<bool, ByteCount> present {};
+			for (char c : bytes)
+			{
+				present[static_cast<unsigned char>(c)] = true;
+			}
+
+			for (size_t c = 0; c < ByteCount;)
+			{
+				if (!present[c])
+				{
+					++c;
+					continue;
+				}
+				const size_t first = c;
+				while (c < ByteCount && present[c])
+				{
+					++c;
+				}
+				if (rangeCount == MaxRanges)
+				{
+					throw std::logic_error("Too many ranges");
+				}
+				Add({static_cast<unsigned char>(first), static_cast<unsigned char>(c - 1)});
+			}
+		}
+
+		bool Contains(char c) const
+		{
+			return table[static_cast<unsigned char>(c)];
+		}
+
+		bool operator()(char c) const
+		{
+			return Contains(c);
+		}
+
+		size_t RangeCount() const
+		{
+			return rangeCount;
+		}
+
+		char Bias(size_t index) const
+		{
+			return bias[index];
+		}
+
+		char Limit(size_t index) const
+		{
+			return limit[index];
+		}
+
+	private:
+		void Add(Range range)
+		{
+			if (range.first > range.last)
+			{
+				throw std::logic_error("Invalid range");
+			}
+			bias[rangeCount] = static_cast<char>(SignBias - range.first);
+			limit[rangeCount] = static_cast<char>(range.last - range.first - SignBias);
+			++rangeCount;
+
+			for (unsigned int c = range.first; c <= range.last; ++c)
+			{
+				table[c] = true;
+			}
+		}
+	};
+
+	namespace Detail
+	{
+		inline unsigned int CountTrailingZeros(unsigned int value)
+		{
+#ifdef _MSC_VER
+			unsigned long index {};
+			(void) _BitScanForward(&index, value);
+			return index;
+#else
+			return static_cast<unsigned int>(__builtin_ctz(value));
+#endif
+		}
+
+#if defined(GLIB_BYTESET_AVX2)
+		constexpr size_t BlockSize = 32;
+		constexpr unsigned int BlockMask = 0xFFFFFFFFU;
+
+		inline unsigned int MatchBlock(const char * p, const ByteSet & set)
+		{
+			const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast) intrinsic
+			const __m256i ones = _mm256_set1_epi8(-1);
+			__m256i match = _mm256_setzero_si256();
+			for (size_t i = 0; i < set.RangeCount(); ++i)
+			{
+				const __m256i biased = _mm256_add_epi8(value, _mm256_set1_epi8(set.Bias(i)));
+				match = _mm256_or_si256(match, _mm256_xor_si256(_mm256_cmpgt_epi8(biased, _mm256_set1_epi8(set.Limit(i))), ones));
+			}
+			return static_cast<unsigned int>(_mm256_movemask_epi8(match));
+		}
+#elif defined(GLIB_BYTESET_SSE2)
+		constexpr size_t BlockSize = 16;
+		constexpr unsigned int BlockMask = 0xFFFFU;
+
+		inline unsigned int MatchBlock(const char * p, const ByteSet & set)
+		{
+			const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast) intrinsic
+			const __m128i ones = _mm_set1_epi8(-1);
+			__m128i match = _mm_setzero_si128();
+			for (size_t i = 0; i < set.RangeCount(); ++i)
+			{
+				const __m128i biased = _mm_add_epi8(value, _mm_set1_epi8(set.Bias(i)));
+				match = _mm_or_si128(match, _mm_xor_si128(_mm_cmpgt_epi8(biased, _mm_set1_epi8(set.Limit(i))), ones));
+			}
+			return static_cast<unsigned int>(_mm_movemask_epi8(match));
+		}
+#endif
+
+		template <bool Want>
+		size_t Find(std::string_view value, const ByteSet & set, size_t pos)
+		{
+			const size_t size = value.size();
+#if defined(GLIB_BYTESET_AVX2) || defined(GLIB_BYTESET_SSE2)
+			for (; pos <= size && size - pos >= BlockSize; pos += BlockSize)
+			{
+				unsigned int mask = MatchBlock(value.data() + pos, set); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) block scan
+				if constexpr (!Want)
+				{
+					mask = ~mask & BlockMask;
+				}
+				if (mask != 0)
+				{
+					return pos + CountTrailingZeros(mask);
+				}
+			}
+#endif
+			for (; pos < size; ++pos)
+			{
+				if (set.Contains(value[pos]) == Want)
+				{
+					return pos;
+				}
+			}
+			return std::string_view::npos;
+		}
+	}
+
+	inline size_t FindFirstOf(std::string_view value, const ByteSet & set, size_t pos = 0)
+	{
+		return Detail::Find<true>(value, set, pos);
+	}
+
+	inline size_t FindFirstNotOf(std::string_view value, const ByteSet & set, size_t pos = 0)
+	{
+		return Detail::Find<false>(value, set, pos);
+	}
+
+	namespace ByteSets
+	{
+		// C locale isalnum || '_'
+		inline const ByteSet & Identifier()
+		{
+			static const ByteSet set {{'0', '9'}, {'A', 'Z'}, {'_', '_'}, {'a', 'z'}};
+			return set;
+		}
+
+		// C locale isspace
+		inline const ByteSet & WhiteSpace()
+		{
+			static const ByteSet set {{'\t', '\r'}, {' ', ' '}};
+			return set;
+		}
+	}
+}
@@ -1,12 +1,11 @@
 #pragma once
 
 #include <GLib/Cpp/Iterator.h>
+#include <GLib/PerfectHash.h>
 #include <GLib/Xml/Utils.h>
 #include <GLib/split.h>
 
-#include <cctype>
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
 enum class Style : char
@@ -51,7 +50,7 @@ inline void Span(Style cls, const std::string_view & value, std::ostream & s)
 
 inline bool IsKeyword(const std::string_view & value)
 {
-	static const std::unordered_set<std::string_view> keywords
+	static constexpr auto keywords = GLib::Util::MakePerfectHashSet(
 	{
 		"alignas","alignof","and","and_eq","asm","atomic_cancel","atomic_commit","atomic_noexcept","auto",
 		"bitand","bitor","bool","break","case","catch","char","char8_t","char16_t","char32_t","class","compl",
@@ -63,20 +62,20 @@ inline bool IsKeyword(const std::string_view & value)
 		"struct","switch","synchronized","template","this","thread_local","throw","true","try","typedef","typeid",
 		"typename","union","unsigned","using","virtual","void","volatile","wchar_t","while","xor","xor_eq",
 		"override","final"
-	};
-	return keywords.find(value) != keywords.end();
+	});
+	return keywords.contains(value);
 }
 
 inline bool IsCommonType(const std::string_view & value)
 {
-	static const std::unordered_set<std::string_view> types
+	static constexpr auto types = GLib::Util::MakePerfectHashSet(
 	{
 		"array", "bitset", "deque", "initializer_list", "istringstream", "list", "map", "multimap", "multiset",
 		"ostream", "ostringstream", "pair", "queue", "set", "size_t", "string", "string_view", "shared_ptr",
 		"stack", "stringstream", "unique_ptr", "unordered_map", "unordered_multimap", "unordered_multiset",
 		"unordered_set", "vector"
-	};
-	return types.find(value) != types.end();
+	});
+	return types.contains(value);
 }
 
 inline void Htmlify(const GLib::Cpp::Holder & code, std::ostream & out)
@@ -92,8 +91,8 @@ inline void Htmlify(const GLib::Cpp::Holder & code, std::ostream & out)
 		{ GLib::Cpp::State::Directive, Style::Directive},
 	};
 
-	auto alphaNumUnd = [](unsigned char c) { return std::isalnum(c) != 0 || c == '_'; };
-	auto whitespace = [](unsigned char c) { return std::isspace(c) != 0; };
+	const GLib::Util::ByteSet & alphaNumUnd = GLib::Util::ByteSets::Identifier();
+	const GLib::Util::ByteSet & whitespace = GLib::Util::ByteSets::WhiteSpace();
 
 	for (auto f : code)
 	{
@@ -0,0 +1,338 @@
+#pragma once
+
+#include <GLib/ByteSet.h>
+
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace GLib::Util
+{
+	// quote and escape are disabled with '\0', a quote inside a quoted field is written twice, an escape keeps the next byte as is
+	struct DelimitedFormat
+	{
+		std::string delimiters = ",";
+		char quote = '"';
+		char escape = '\0';
+
+		static DelimitedFormat Csv()
+		{
+			return {",", '"', '\0'};
+		}
+
+		static DelimitedFormat Tsv()
+		{
+			return {"\t", '\0', '\\'};
+		}
+	};
+
+	class StreamSource
+	{
+		std::istream & stream;
+
+	public:
+		explicit StreamSource(std::istream & stream)
+			: stream(stream)
+		{}
+
+		size_t operator()(char * buffer, size_t size)
+		{
+			(void) stream.read(buffer, static_cast<std::streamsize>(size));
+			return static_cast<size_t>(stream.gcount());
+		}
+	};
+
+	class ViewSource
+	{
+		std::string_view value;
+
+	public:
+		explicit ViewSource(std::string_view value)
+			: value(value)
+		{}
+
+		size_t operator()(char * buffer, size_t size)
+		{
+			const size_t count = std::min(size, value.size());
+			std::memcpy(buffer, value.data(), count);
+			value.remove_prefix(count);
+			return count;
+		}
+	};
+
+	// reads records of delimited fields chunk by chunk from Source: size_t(char * buffer, size_t size), returning 0 at the end
+	// fields are views into the chunk buffer, or into a per record buffer when unescaping was needed, valid until the next call
+	template <typename Source>
+	class DelimitedReader
+	{
+		static constexpr size_t DefaultChunkSize = 64 * 1024;
+
+		struct Field
+		{
+			size_t offset;
+			size_t length;
+			bool unescaped;
+		};
+
+		enum class Result
+		{
+			Record,
+			NeedMore,
+			End
+		};
+
+		Source source;
+		DelimitedFormat format;
+		ByteSet unquotedSpecials;
+		ByteSet quotedSpecials;
+
+		std::vector<char> buffer;
+		size_t begin {};
+		size_t end {};
+		bool eof {};
+
+		size_t recordBegin {};
+		std::vector<Field> fields;
+		std::string unescaped;
+
+	public:
+		DelimitedReader(Source source, DelimitedFormat format = {}, size_t chunkSize = DefaultChunkSize)
+			: source(std::move(source))
+			, format(std::move(format))
+			, unquotedSpecials(UnquotedSpecials(this->format))
+			, quotedSpecials(QuotedSpecials(this->format))
+			, buffer(std::max<size_t>(chunkSize, 1))
+		{
+			if (this->format.delimiters.empty())
+			{
+				throw std::logic_error("Delimiter is empty");
+			}
+		}
+
+		bool Next(std::vector<std::string_view> & record)
+		{
+			for (;;)
+			{
+				switch (Parse())
+				{
+					case Result::Record:
+						record.clear();
+						for (const auto & field : fields)
+						{
+							const char * base = field.unescaped ? unescaped.data() : buffer.data() + recordBegin; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) buffer offset
+							record.emplace_back(base + field.offset, field.length); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) buffer offset
+						}
+						return true;
+
+					case Result::End:
+						return false;
+
+					case Result::NeedMore:
+						Fill();
+						break;
+				}
+			}
+		}
+
+	private:
+		static ByteSet UnquotedSpecials(const DelimitedFormat & format)
+		{
+			std::string specials = format.delimiters + '\n';
+			if (format.escape != '\0')
+			{
+				specials += format.escape;
+			}
+			return ByteSet {specials};
+		}
+
+		static ByteSet QuotedSpecials(const DelimitedFormat & format)
+		{
+			std::string specials;
+			specials += format.quote;
+			if (format.escape != '\0')
+			{
+				specials += format.escape;
+			}
+			return ByteSet {specials};
+		}
+
+		void Fill()
+		{
+			if (begin != 0)
+			{
+				std::memmove(buffer.data(), buffer.data() + begin, end - begin); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) buffer offset
+				end -= begin;
+				begin = 0;
+			}
+
+			if (end == buffer.size())
+			{
+				buffer.resize(buffer.size() * 2); // a record larger than the buffer
+			}
+
+			const size_t read = source(buffer.data() + end, buffer.size() - end); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) buffer offset
+			end += read;
+			eof = read == 0;
+		}
+
+		bool IsDelimiter(char c) const
+		{
+			return format.delimiters.find(c) != std::string::npos;
+		}
+
+		void AppendUnescaped(std::string_view value, bool & copying, size_t & copyStart)
+		{
+			if (!copying)
+			{
+				copying = true;
+				copyStart = unescaped.size();
+			}
+			unescaped += value;
+		}
+
+		Result Parse()
+		{
+			const std::string_view data {buffer.data() + begin, end - begin}; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) buffer offset
+			if (data.empty())
+			{
+				return eof ? Result::End : Result::NeedMore;
+			}
+
+			fields.clear();
+			unescaped.clear();
+
+			for (size_t pos = 0;;)
+			{
+				if (pos == data.size() && !eof)
+				{
+					return Result::NeedMore;
+				}
+
+				bool copying {};
+				size_t copyStart {};
+				Field field {};
+
+				if (format.quote != '\0' && pos != data.size() && data[pos] == format.quote)
+				{
+					const size_t start = ++pos;
+					for (;;)
+					{
+						const size_t q = FindFirstOf(data, quotedSpecials, pos);
+						if (q == std::string_view::npos || q + 1 == data.size())
+						{
+							if (!eof)
+							{
+								return Result::NeedMore;
+							}
+							if (q == std::string_view::npos || data[q] != format.quote)
+							{
+								throw std::runtime_error("Unterminated quoted field");
+							}
+						}
+
+						if (data[q] != format.quote || (q + 1 != data.size() && data[q + 1] == format.quote))
+						{
+							// escape or doubled quote, keep the following character
+							AppendUnescaped(data.substr(pos, q - pos), copying, copyStart);
+							unescaped += data[q + 1];
+							pos = q + 2;
+							continue;
+						}
+
+						if (copying)
+						{
+							unescaped += data.substr(pos, q - pos);
+							field = {copyStart, unescaped.size() - copyStart, true};
+						}
+						else
+						{
+							field = {start, q - start, false};
+						}
+						pos = q + 1;
+						break;
+					}
+
+					if (pos != data.size() && data[pos] == '\r')
+					{
+						if (pos + 1 == data.size() && !eof)
+						{
+							return Result::NeedMore;
+						}
+						if (pos + 1 == data.size() || data[pos + 1] == '\n')
+						{
+							++pos;
+						}
+					}
+				}
+				else
+				{
+					const size_t start = pos;
+					for (;;)
+					{
+						size_t q = FindFirstOf(data, unquotedSpecials, pos);
+						if (q == std::string_view::npos)
+						{
+							if (!eof)
+							{
+								return Result::NeedMore;
+							}
+							q = data.size();
+						}
+						else if (format.escape != '\0' && data[q] == format.escape)
+						{
+							if (q + 1 == data.size())
+							{
+								if (!eof)
+								{
+									return Result::NeedMore;
+								}
+								throw std::runtime_error("Trailing escape");
+							}
+							AppendUnescaped(data.substr(pos, q - pos), copying, copyStart);
+							unescaped += data[q + 1];
+							pos = q + 2;
+							continue;
+						}
+
+						size_t fieldEnd = q;
+						if (q != data.size() && data[q] == '\n' && fieldEnd > pos && data[fieldEnd - 1] == '\r')
+						{
+							--fieldEnd;
+						}
+
+						if (copying)
+						{
+							unescaped += data.substr(pos, fieldEnd - pos);
+							field = {copyStart, unescaped.size() - copyStart, true};
+						}
+						else
+						{
+							field = {start, fieldEnd - start, false};
+						}
+						pos = q;
+						break;
+					}
+				}
+
+				fields.push_back(field);
+
+				if (pos == data.size() || data[pos] == '\n')
+				{
+					recordBegin = begin;
+					begin += std::min(pos + 1, data.size());
+					return Result::Record;
+				}
+
+				if (!IsDelimiter(data[pos]))
+				{
+					throw std::runtime_error("Malformed quoted field");
+				}
+				++pos;
+			}
+		}
+	};
+}
@@ -42,7 +42,7 @@ namespace GLib::Eval
 			return stm.str();
 		}
 
-		void VisitProperty(const std::string & propertyName, const ValueVisitor & visitor) const override
+		void VisitProperty(std::string_view propertyName, const ValueVisitor & visitor) const override
 		{
 			(void) propertyName;
 			(void) visitor;
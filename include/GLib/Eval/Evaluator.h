@@ -4,21 +4,24 @@
 #include <GLib/split.h>
 
 #include <functional>
+#include <map>
 #include <stdexcept>
+#include <string_view>
 
 namespace GLib::Eval
 {
 	// move?
 	template <typename T, std::enable_if_t<std::is_class<T>::value> * = nullptr>
-	void VisitProperty(const T & value, const std::string & propertyName)
+	void VisitProperty(const T & value, std::string_view propertyName)
 	{
 		Visitor<T>::Visit(propertyName, value);
 	}
 
 	class Evaluator
 	{
-		std::unordered_map<std::string, ValuePtr> values;
-		std::unordered_map<std::string, const ValueBase &> localValues;
+		// transparent comparators so path segments are looked up as views without building a string
+		std::map<std::string, ValuePtr, std::less<>> values;
+		std::map<std::string, const ValueBase &, std::less<>> localValues;
 
 	public:
 		template <typename ValueType>
@@ -54,12 +57,12 @@ namespace GLib::Eval
 			}
 		}
 
-		void Remove(const std::string & name)
+		void Remove(std::string_view name)
 		{
 			const auto it = values.find(name);
 			if (it == values.end())
 			{
-				throw std::runtime_error("Value not found : " + name);
+				throw std::runtime_error("Value not found : " + std::string {name});
 			}
 			values.erase(it);
 		}
@@ -72,20 +75,22 @@ namespace GLib::Eval
 			}
 		}
 
-		void Pop(const std::string & name)
+		void Pop(std::string_view name)
 		{
-			if (localValues.erase(name) == 0)
+			const auto it = localValues.find(name);
+			if (it == localValues.end())
 			{
-				throw std::runtime_error(std::string("Local value not found : ") + name);
+				throw std::runtime_error("Local value not found : " + std::string {name});
 			}
+			localValues.erase(it);
 		}
 
-		void ForEach(const std::string & name, const ValueVisitor & visitor) const
+		void ForEach(std::string_view name, const ValueVisitor & visitor) const
 		{
 			Evaluate(name, [&](const ValueBase & value) { value.ForEach(visitor); });
 		}
 
-		std::string Evaluate(const std::string & name) const
+		std::string Evaluate(std::string_view name) const
 		{
 			std::string result;
 			Evaluate(name, [&](const ValueBase & value) { result = value.ToString(); });
@@ -93,22 +98,23 @@ namespace GLib::Eval
 		}
 
 	private:
-		void Evaluate(const std::string & value, const ValueVisitor & visitor) const
+		void Evaluate(std::string_view value, const ValueVisitor & visitor) const
 		{
-			const auto & s = GLib::Util::Splitter {value, "."};
+			const auto & s = GLib::Util::Splitter {GLib::Util::NonOwning, value, "."};
 			auto it = s.begin();
+			const std::string_view name = *it;
 
-			const auto lit = localValues.find(*it);
+			const auto lit = localValues.find(name);
 			if (lit != localValues.end())
 			{
 				++it;
 				return SubEvaluate(lit->second, it, s.end(), visitor);
 			}
 
-			const auto vit = values.find(*it);
+			const auto vit = values.find(name);
 			if (vit == values.end())
 			{
-				throw std::runtime_error("Value not found : " + *it);
+				throw std::runtime_error("Value not found : " + std::string {name});
 			}
 			++it;
 			SubEvaluate(*vit->second, it, s.end(), visitor);
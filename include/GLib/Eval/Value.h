@@ -1,11 +1,13 @@
 #pragma once
 
 #include <GLib/Eval/Utils.h>
+#include <GLib/PerfectHash.h>
 #include <GLib/compat.h>
 
 #include <functional>
 #include <memory>
 #include <string>
+#include <string_view>
 
 namespace GLib::Eval
 {
@@ -53,7 +55,7 @@ namespace GLib::Eval
 
 		virtual std::string ToString() const = 0; // +format/stream?
 
-		virtual void VisitProperty(const std::string & propertyName, const ValueVisitor & f) const = 0;
+		virtual void VisitProperty(std::string_view propertyName, const ValueVisitor & f) const = 0;
 		virtual void ForEach(const ValueVisitor & f) const = 0;
 	};
 
@@ -72,7 +74,7 @@ namespace GLib::Eval
 			return Utils::ToString(value);
 		}
 
-		void VisitProperty(const std::string & propertyName, const ValueVisitor & visitor) const override
+		void VisitProperty(std::string_view propertyName, const ValueVisitor & visitor) const override
 		{
 			Visitor<ValueType>::Visit(value, propertyName, visitor);
 		}
@@ -83,15 +85,48 @@ namespace GLib::Eval
 		}
 	};
 
+	template <typename ValueType>
+	using PropertyAccessor = void (*)(const ValueType &, const ValueVisitor &);
+
+	// property name to accessor built at compile time, one lookup replaces a chain of name compares in a Visitor
+	template <typename ValueType, size_t N>
+	class PropertyTable
+	{
+		Util::PerfectHashMap<PropertyAccessor<ValueType>, N> accessors;
+
+	public:
+		explicit constexpr PropertyTable(const Util::PerfectHashMap<PropertyAccessor<ValueType>, N> & accessors)
+			: accessors(accessors)
+		{}
+
+		void Visit(const ValueType & value, std::string_view propertyName, const ValueVisitor & f) const
+		{
+			const PropertyAccessor<ValueType> * accessor = accessors.find(propertyName);
+			if (accessor == nullptr)
+			{
+				throw std::runtime_error("Unknown property : '" + std::string {propertyName} + '\'');
+			}
+			(*accessor)(value, f);
+		}
+	};
+
+	// static constexpr auto properties = MakePropertyTable<User>({{"name", [](const User & u, const ValueVisitor & f) { f(Value(u.name)); }}});
+	template <typename ValueType, size_t N>
+	constexpr PropertyTable<ValueType, N> MakePropertyTable(
+		const std::pair<std::string_view, PropertyAccessor<ValueType>> (&properties)[N]) // NOLINT(cppcoreguidelines-avoid-c-arrays,hicpp-avoid-c-arrays,modernize-avoid-c-arrays)
+	{
+		return PropertyTable<ValueType, N> {Util::MakePerfectHashMap<PropertyAccessor<ValueType>>(properties)};
+	}
+
 	template <typename Value>
 	struct Visitor
 	{
-		static void Visit(const Value & value, const std::string & propertyName, const ValueVisitor & visitor)
+		static void Visit(const Value & value, std::string_view propertyName, const ValueVisitor & visitor)
 		{
 			(void) value;
 			(void) visitor;
 
-			throw std::runtime_error(std::string("No accessor defined for property: '") + propertyName + "', type:'" +
+			throw std::runtime_error("No accessor defined for property: '" + std::string {propertyName} + "', type:'" +
 															 Compat::Unmangle(typeid(Value).name()) + '\'');
 		}
 	};
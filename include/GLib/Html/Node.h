@@ -1,6 +1,7 @@
 #pragma once
 
 #include <list>
+#include <memory_resource>
 #include <string>
 #include <string_view>
 
@@ -13,15 +14,21 @@ namespace GLib::Html
 		std::string variable;
 		std::string enumeration;
 		std::string_view condition;
-		std::list<Node> children; // use ostream for xml fragmemts, single optional child for the rest, polymorphic?
+		std::pmr::list<Node> children; // use ostream for xml fragmemts, single optional child for the rest, polymorphic?
 		size_t const depth {};
 
 	public:
 		Node() = default;
 
+		// root of a tree whose nodes are allocated from resource
+		explicit Node(std::pmr::memory_resource * resource)
+			: children(resource)
+		{}
+
 		Node(Node * parent, std::string_view value)
 			: parent(parent)
 			, value(value)
+			, children(ResourceOf(parent))
 		{}
 
 		Node(Node * parent, std::string variable, std::string enumeration, std::string_view condition, size_t depth)
@@ -29,12 +36,14 @@ namespace GLib::Html
 			, variable(move(variable))
 			, enumeration(move(enumeration))
 			, condition(condition)
+			, children(ResourceOf(parent))
 			, depth(depth)
 		{}
 
 		Node(Node * parent, std::string_view condition, bool unused)
 			: parent(parent)
 			, condition(condition)
+			, children(ResourceOf(parent))
 		{
 			(void) unused;
 		}
@@ -64,7 +73,7 @@ namespace GLib::Html
 			return condition;
 		}
 
-		const std::list<Node> & Children() const
+		const std::pmr::list<Node> & Children() const
 		{
 			return children;
 		}
@@ -74,6 +83,12 @@ namespace GLib::Html
 			return depth;
 		}
 
+		// children share the resource of the root
+		static std::pmr::memory_resource * ResourceOf(const Node * parent)
+		{
+			return parent != nullptr ? parent->children.get_allocator().resource() : std::pmr::get_default_resource();
+		}
+
 		Node * AddFragment(const std::string_view & fragment = {})
 		{
 			children.emplace_back(this, fragment);
@@ -4,8 +4,10 @@
 
 #include <GLib/Eval/Evaluator.h>
 #include <GLib/PairHash.h>
+#include <GLib/PerfectHash.h>
 #include <GLib/Xml/Iterator.h>
 
+#include <memory_resource>
 #include <ostream>
 #include <regex>
 
@@ -21,6 +23,15 @@ namespace GLib::Html
 		static constexpr auto If = std::string_view {"if"};
 		static constexpr auto Text = std::string_view {"text"};
 
+		enum class Directive
+		{
+			If,
+			Each,
+			Text
+		};
+
+		static constexpr auto directives = Util::MakePerfectHashMap<Directive>({{If, Directive::If}, {Each, Directive::Each}, {Text, Directive::Text}});
+
 		std::regex const propRegex {R"(\$\{([\w\.]+)\})"};
 		std::regex const varRegex {R"(^(\w+)\s:\s\$\{([\w\.]+)\}$)"};
 
@@ -34,7 +45,13 @@ namespace GLib::Html
 
 		void Generate(const std::string_view & xml, std::ostream & out)
 		{
-			Generate(Parse(xml), out);
+			Generate(Parse(xml, std::pmr::get_default_resource()), out);
+		}
+
+		// the parser state and node tree are allocated from resource e.g. Util::ThreadArenaResource(), reset by the caller afterwards
+		void Generate(const std::string_view & xml, std::ostream & out, std::pmr::memory_resource * resource)
+		{
+			Generate(Parse(xml, resource), out);
 		}
 
 	private:
@@ -43,12 +60,12 @@ namespace GLib::Html
 			return value.data() + value.size(); // &*value.rbegin()+1;
 		}
 
-		Node Parse(const std::string_view xml)
+		Node Parse(const std::string_view xml, std::pmr::memory_resource * resource)
 		{
-			Node root;
+			Node root {resource};
 			Node * current = &root;
 
-			Xml::Holder holder {xml};
+			Xml::Holder holder {xml, resource};
 			const auto & manager = holder.Manager();
 
 			for (auto it = holder.begin(), end = holder.end(); it != end; ++it)
@@ -199,23 +216,32 @@ namespace GLib::Html
 			{
 				if (namespaceName.first == NameSpace)
 				{
-					if (namespaceName.second == If)
-					{
-						iff = a.value;
-						modified = true;
-					}
-					else if (namespaceName.second == Each)
-					{
-						each = a.value;
-						modified = true;
-					}
-					else if (namespaceName.second == Text)
+					if (const Directive * directive = directives.find(namespaceName.second))
 					{
-						if (e.Type() != Xml::ElementType::Open)
+						switch (*directive)
 						{
-							throw std::runtime_error("Misplaced Attribute");
+							case Directive::If:
+							{
+								iff = a.value;
+								break;
+							}
+
+							case Directive::Each:
+							{
+								each = a.value;
+								break;
+							}
+
+							case Directive::Text:
+							{
+								if (e.Type() != Xml::ElementType::Open)
+								{
+									throw std::runtime_error("Misplaced Attribute");
+								}
+								text = a.value;
+								break;
+							}
 						}
-						text = a.value;
 						modified = true;
 					}
 					else
@@ -325,7 +351,7 @@ namespace GLib::Html
 					throw std::runtime_error("Error in if value : " + std::string(condition));
 				}
 
-				auto result = evaluator.Evaluate(m[1]);
+				auto result = evaluator.Evaluate(condition.substr(static_cast<size_t>(m.position(1)), static_cast<size_t>(m.length(1))));
 				if (result == "false")
 				{
 					return;
@@ -367,7 +393,7 @@ namespace GLib::Html
 					{
 						out << it->prefix();
 						const auto & var = (*it)[1]; // +format;
-						out << evaluator.Evaluate(var);
+						out << evaluator.Evaluate(std::string_view {var.first, static_cast<size_t>(var.length())});
 						auto suffix = it++->suffix(); // capture before ++
 						if (it == end)
 						{
@@ -389,4 +415,9 @@ namespace GLib::Html
 	{
 		Generator(e).Generate(xml, out);
 	}
+
+	inline void Generate(Eval::Evaluator & e, const std::string_view & xml, std::ostream & out, std::pmr::memory_resource * resource)
+	{
+		Generator(e).Generate(xml, out, resource);
+	}
 }
\ No newline at end of file
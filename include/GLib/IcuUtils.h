@@ -1,13 +1,25 @@
 #pragma once
 
+#include <GLib/ByteSet.h>
 #include <GLib/stackorheap.h>
 
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 #ifdef __linux__
+#include <unicode/uchar.h>
 #include <unicode/ucol.h>
 #include <unicode/ucasemap.h>
+#include <unicode/uset.h>
+#include <unicode/ustring.h>
 #elif _MSC_VER
 #include <icu.h>
 #pragma comment(lib, "icuuc.lib")
@@ -55,6 +67,54 @@ namespace GLib::IcuUtils
 			return CollatorPtr(col);
 		}
 
+		inline std::string LocaleKey(const char * locale)
+		{
+			return locale == nullptr ? std::string {} : std::string {locale};
+		}
+
+		// opened once per process and locale, the open is far more expensive than a clone
+		inline const UCollator & NoCaseCollatorPrototype(const char * locale)
+		{
+			static std::mutex mutex;
+			static std::unordered_map<std::string, CollatorPtr> prototypes;
+
+			const std::lock_guard<std::mutex> lock(mutex);
+			CollatorPtr & prototype = prototypes[LocaleKey(locale)];
+			if (!prototype)
+			{
+				CollatorPtr collator = MakeCollator(locale);
+				::ucol_setStrength(collator.get(), UCOL_SECONDARY);
+				prototype = std::move(collator);
+			}
+			return *prototype;
+		}
+
+		inline CollatorPtr CloneCollator(const UCollator & collator)
+		{
+			UErrorCode error = U_ZERO_ERROR;
+#if U_ICU_VERSION_MAJOR_NUM >= 71
+			UCollator * clone = ::ucol_clone(&collator, &error);
+#else
+			UCollator * clone = ::ucol_safeClone(&collator, nullptr, nullptr, &error);
+#endif
+			AssertNoError(error, "ucol_clone");
+			return CollatorPtr(clone);
+		}
+
+		// secondary strength collator for the calling thread, collators are not shared between threads
+		inline const UCollator * NoCaseCollator(const char * locale)
+		{
+			thread_local std::unordered_map<std::string, CollatorPtr> collators;
+
+			std::string key = LocaleKey(locale);
+			auto it = collators.find(key);
+			if (it == collators.end())
+			{
+				it = collators.emplace(std::move(key), CloneCollator(NoCaseCollatorPrototype(locale))).first;
+			}
+			return it->second.get();
+		}
+
 		struct UCaseMapCloser
 		{
 			void operator()(UCaseMap * map) const noexcept
@@ -72,6 +132,190 @@ namespace GLib::IcuUtils
 			AssertNoError(error, "ucasemap_open");
 			return UCaseMapPtr(ucaseMap);
 		}
+
+		inline const UCaseMap * CaseMap(const char * locale)
+		{
+			thread_local std::unordered_map<std::string, UCaseMapPtr> maps;
+
+			std::string key = LocaleKey(locale);
+			auto it = maps.find(key);
+			if (it == maps.end())
+			{
+				it = maps.emplace(std::move(key), MakeUCaseMap(locale)).first;
+			}
+			return it->second.get();
+		}
+
+		using CaseMapFunction = int32_t (*)(const UCaseMap *, char *, int32_t, const char *, int32_t, UErrorCode *);
+
+		// most values fit the stack buffer so are mapped in one pass, otherwise the required length is used for a second
+		inline std::string MapCase(CaseMapFunction function, const char * name, const std::string & value, const char * locale)
+		{
+			const UCaseMap * map = CaseMap(locale);
+			const auto sourceLength = static_cast<int32_t>(value.size());
+
+			Util::CharBuffer s;
+			UErrorCode error = U_ZERO_ERROR;
+			int32_t destLength = function(map, s.Get(), static_cast<int32_t>(s.size()), value.c_str(), sourceLength, &error);
+			if (error == U_BUFFER_OVERFLOW_ERROR)
+			{
+				error = U_ZERO_ERROR;
+				s.EnsureSize(static_cast<size_t>(destLength));
+				destLength = function(map, s.Get(), destLength, value.c_str(), sourceLength, &error);
+			}
+			AssertNoError(error, name);
+			return {s.Get(), static_cast<size_t>(destLength)};
+		}
+	}
+
+	namespace Detail
+	{
+		struct USetCloser
+		{
+			void operator()(USet * set) const noexcept
+			{
+				::uset_close(set);
+			}
+		};
+
+		using USetPtr = std::unique_ptr<USet, USetCloser>;
+
+		constexpr unsigned char FirstPrintableAscii = 0x20;
+		constexpr unsigned char LastPrintableAscii = 0x7E;
+
+		inline char FoldAscii(char c)
+		{
+			constexpr unsigned int LetterCount = 26;
+			constexpr unsigned int CaseBit = 0x20;
+			const unsigned int u = static_cast<unsigned char>(c);
+			return static_cast<char>(u | (static_cast<unsigned int>(u - static_cast<unsigned int>('A') < LetterCount) * CaseBit));
+		}
+
+		inline bool IsPrintableAscii(std::string_view value)
+		{
+			static const Util::ByteSet printable {{FirstPrintableAscii, LastPrintableAscii}};
+			return Util::FindFirstNotOf(value, printable) == std::string_view::npos;
+		}
+
+		inline bool HasAttribute(const UCollator & collator, UColAttribute attribute, UColAttributeValue value)
+		{
+			UErrorCode error = U_ZERO_ERROR;
+			const UColAttributeValue actual = ::ucol_getAttribute(&collator, attribute, &error);
+			AssertNoError(error, "ucol_getAttribute");
+			return actual == value;
+		}
+
+		// printable ascii collates character by character unless the locale has contractions or expansions for it, e.g. danish "aa",
+		// ignores punctuation (alternate shifted, "a-b" == "ab") or orders digits numerically ("a10" > "a9")
+		inline bool CollatesPerCharacter(const UCollator & collator)
+		{
+			if (!HasAttribute(collator, UCOL_ALTERNATE_HANDLING, UCOL_NON_IGNORABLE) || !HasAttribute(collator, UCOL_NUMERIC_COLLATION, UCOL_OFF))
+			{
+				return false;
+			}
+
+			USetPtr contractions {::uset_openEmpty()};
+			USetPtr expansions {::uset_openEmpty()};
+			UErrorCode error = U_ZERO_ERROR;
+			::ucol_getContractionsAndExpansions(&collator, contractions.get(), expansions.get(), FALSE, &error);
+			AssertNoError(error, "ucol_getContractionsAndExpansions");
+
+			for (UChar32 c = FirstPrintableAscii; c <= LastPrintableAscii; ++c)
+			{
+				if (::uset_contains(expansions.get(), c) != FALSE)
+				{
+					return false;
+				}
+			}
+
+			constexpr int32_t MaxContractionLength = 16;
+			std::array<UChar, MaxContractionLength> buffer {};
+			for (int32_t i = 0, count = ::uset_getItemCount(contractions.get()); i < count; ++i)
+			{
+				UChar32 start {};
+				UChar32 end {};
+				error = U_ZERO_ERROR;
+				const int32_t length = ::uset_getItem(contractions.get(), i, &start, &end, buffer.data(), MaxContractionLength, &error);
+				if (error == U_BUFFER_OVERFLOW_ERROR)
+				{
+					return false;
+				}
+				AssertNoError(error, "uset_getItem");
+
+				auto printable = [](UChar c) { return c >= FirstPrintableAscii && c <= LastPrintableAscii; };
+				if (length > 0 && std::all_of(buffer.begin(), buffer.begin() + length, printable))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		// secondary strength order of printable ascii for the default locale, ranks are equal for characters that compare equal
+		struct AsciiCollation
+		{
+			std::array<unsigned char, LastPrintableAscii + 1> rank {};
+			bool perCharacter {}; // ranks compare strings as the collator does
+			bool caseFold {};			// equal ranks are exactly the a-z, A-Z case pairs, not so for turkish dotless i
+		};
+
+		inline AsciiCollation MakeAsciiCollation(const UCollator & collator)
+		{
+			AsciiCollation result;
+			result.perCharacter = CollatesPerCharacter(collator);
+			if (!result.perCharacter)
+			{
+				return result;
+			}
+
+			auto compare = [&](UChar c1, UChar c2) { return ::ucol_strcoll(&collator, &c1, 1, &c2, 1); };
+
+			std::array<UChar, LastPrintableAscii - FirstPrintableAscii + 1> chars {};
+			for (size_t i = 0; i < chars.size(); ++i)
+			{
+				chars[i] = static_cast<UChar>(FirstPrintableAscii + i);
+			}
+			std::stable_sort(chars.begin(), chars.end(), [&](UChar c1, UChar c2) { return compare(c1, c2) == UCOL_LESS; });
+
+			unsigned char rank = 1;
+			for (size_t i = 0; i < chars.size(); ++i)
+			{
+				if (i != 0 && compare(chars[i - 1], chars[i]) != UCOL_EQUAL)
+				{
+					++rank;
+				}
+				result.rank[chars[i]] = rank;
+			}
+
+			result.caseFold = true;
+			for (unsigned int c1 = FirstPrintableAscii; c1 <= LastPrintableAscii; ++c1)
+			{
+				for (unsigned int c2 = FirstPrintableAscii; c2 <= LastPrintableAscii; ++c2)
+				{
+					const bool sameRank = result.rank[c1] == result.rank[c2];
+					const bool sameFold = FoldAscii(static_cast<char>(c1)) == FoldAscii(static_cast<char>(c2));
+					result.caseFold = result.caseFold && sameRank == sameFold;
+				}
+			}
+			return result;
+		}
+
+		inline const AsciiCollation & DefaultAsciiCollation()
+		{
+			static const AsciiCollation collation = MakeAsciiCollation(*NoCaseCollator(nullptr));
+			return collation;
+		}
+	}
+
+	// true if value is printable ascii and the default locale folds its case as a-z, A-Z, so it can be hashed without ICU
+	inline bool CanFoldAscii(std::string_view value)
+	{
+		return Detail::IsPrintableAscii(value) && Detail::DefaultAsciiCollation().caseFold;
+	}
+
+	inline char ToLowerAscii(char c)
+	{
+		return Detail::FoldAscii(c);
 	}
 
 	enum class CompareResult : int
@@ -83,8 +327,22 @@ namespace GLib::IcuUtils
 
 	inline CompareResult CompareNoCase(const char * s1, size_t s1size, const char * s2, size_t s2size, const char * locale = nullptr)
 	{
-		auto collator = Detail::MakeCollator(locale); // cache? perf test
-		::ucol_setStrength(collator.get(), UCOL_SECONDARY);
+		// printable ascii is compared by the collation rank of each character, others by ICU
+		const std::string_view v1 {s1, s1size};
+		const std::string_view v2 {s2, s2size};
+		if (locale == nullptr && Detail::DefaultAsciiCollation().perCharacter && Detail::IsPrintableAscii(v1) && Detail::IsPrintableAscii(v2))
+		{
+			const auto & rank = Detail::DefaultAsciiCollation().rank;
+			const auto [it1, it2] = std::mismatch(v1.begin(), v1.end(), v2.begin(), v2.end(),
+																						[&](char c1, char c2) { return rank[static_cast<unsigned char>(c1)] == rank[static_cast<unsigned char>(c2)]; });
+			if (it1 != v1.end() && it2 != v2.end())
+			{
+				return rank[static_cast<unsigned char>(*it1)] < rank[static_cast<unsigned char>(*it2)] ? CompareResult::Less : CompareResult::Greater;
+			}
+			return it1 != v1.end() ? CompareResult::Greater : it2 != v2.end() ? CompareResult::Less : CompareResult::Equal;
+		}
+
+		const UCollator * collator = Detail::NoCaseCollator(locale);
 
 		UCharIterator i1;
 		UCharIterator i2;
@@ -92,7 +350,7 @@ namespace GLib::IcuUtils
 		::uiter_setUTF8(&i2, s2, static_cast<int32_t>(s2size));
 
 		UErrorCode error = U_ZERO_ERROR;
-		UCollationResult result = ::ucol_strcollIter(collator.get(), &i1, &i2, &error);
+		UCollationResult result = ::ucol_strcollIter(collator, &i1, &i2, &error);
 		Detail::AssertNoError(error, "ucol_strcollIter");
 		switch (result)
 		{
@@ -112,37 +370,157 @@ namespace GLib::IcuUtils
 		return CompareNoCase(s1.c_str(), s1.size(), s2.c_str(), s2.size(), locale);
 	}
 
+	namespace Detail
+	{
+		// appends the key without its terminating zero, invalid utf8 is collated as U+FFFD as for CompareNoCase
+		inline void AppendSortKey(std::string & keys, std::string_view value, const UCollator * collator)
+		{
+			constexpr UChar32 Substitute = 0xFFFD;
+
+			Util::StackOrHeap<UChar, Util::DefaultStackReserveSize> utf16;
+			UErrorCode error = U_ZERO_ERROR;
+			int32_t length {};
+			::u_strFromUTF8WithSub(utf16.Get(), static_cast<int32_t>(utf16.size()), &length, value.data(), static_cast<int32_t>(value.size()),
+														 Substitute, nullptr, &error);
+			if (error == U_BUFFER_OVERFLOW_ERROR)
+			{
+				error = U_ZERO_ERROR;
+				utf16.EnsureSize(static_cast<size_t>(length));
+				::u_strFromUTF8WithSub(utf16.Get(), length, &length, value.data(), static_cast<int32_t>(value.size()), Substitute, nullptr, &error);
+			}
+			AssertNoError(error, "u_strFromUTF8WithSub");
+
+			// secondary strength keys are around two bytes per character
+			constexpr size_t KeyOverhead = 8;
+			const size_t start = keys.size();
+			keys.resize(start + static_cast<size_t>(length) * 2 + KeyOverhead);
+			auto getSortKey = [&]
+			{
+				auto * dest = reinterpret_cast<uint8_t *>(keys.data() + start); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast,cppcoreguidelines-pro-bounds-pointer-arithmetic) ICU byte buffer
+				return static_cast<size_t>(::ucol_getSortKey(collator, utf16.Get(), length, dest, static_cast<int32_t>(keys.size() - start)));
+			};
+
+			size_t keyLength = getSortKey();
+			if (keyLength > keys.size() - start)
+			{
+				keys.resize(start + keyLength);
+				keyLength = getSortKey();
+			}
+			AssertTrue(keyLength != 0, "ucol_getSortKey");
+			keys.resize(start + keyLength - 1);
+		}
+	}
+
+	// collation key that orders as CompareNoCase for the same locale with a byte comparison, for maps sorted or searched many times
+	class SortKey
+	{
+		std::string key;
+
+	public:
+		SortKey() = default;
+
+		explicit SortKey(std::string_view value, const char * locale = nullptr)
+		{
+			Detail::AppendSortKey(key, value, Detail::NoCaseCollator(locale));
+		}
+
+		std::string_view Bytes() const noexcept
+		{
+			return key;
+		}
+
+		bool operator<(const SortKey & other) const noexcept
+		{
+			return key < other.key;
+		}
+
+		bool operator==(const SortKey & other) const noexcept
+		{
+			return key == other.key;
+		}
+
+		bool operator!=(const SortKey & other) const noexcept
+		{
+			return key != other.key;
+		}
+	};
+
+	// stable sort of values convertible to std::string_view as NoCaseLess does, with one key per value rather than a collation per comparison
+	template <typename Range>
+	void SortNoCase(Range & range, const char * locale = nullptr)
+	{
+		struct Entry
+		{
+			size_t offset;
+			size_t length;
+			size_t index;
+		};
+
+		const UCollator * collator = Detail::NoCaseCollator(locale);
+		std::string keys;
+		std::vector<Entry> entries;
+		for (const auto & value : range)
+		{
+			const size_t offset = keys.size();
+			Detail::AppendSortKey(keys, std::string_view {value}, collator);
+			entries.push_back({offset, keys.size() - offset, entries.size()});
+		}
+
+		const std::string_view allKeys {keys};
+		std::stable_sort(entries.begin(), entries.end(), [&](const Entry & e1, const Entry & e2)
+										 { return allKeys.substr(e1.offset, e1.length) < allKeys.substr(e2.offset, e2.length); });
+
+		using Value = std::decay_t<decltype(*std::begin(range))>;
+		std::vector<Value> sorted;
+		sorted.reserve(entries.size());
+		const auto begin = std::begin(range);
+		for (const auto & entry : entries)
+		{
+			sorted.push_back(std::move(begin[static_cast<typename std::iterator_traits<decltype(begin)>::difference_type>(entry.index)]));
+		}
+		std::move(sorted.begin(), sorted.end(), begin);
+	}
+
 	inline std::string ToLower(const std::string & value, const char * locale = nullptr)
 	{
-		UErrorCode error = U_ZERO_ERROR;
-		auto map = Detail::MakeUCaseMap(locale); // cache
-
-		const auto sourceLength = static_cast<int32_t>(value.size());
-		const auto destLength = ::ucasemap_utf8ToLower(map.get(), nullptr, 0, value.c_str(), sourceLength, &error);
-		Detail::AssertTrue(error == U_BUFFER_OVERFLOW_ERROR, "ucasemap_utf8ToLower");
-
-		error = U_ZERO_ERROR;
-		Util::CharBuffer s;
-		s.EnsureSize(destLength);
-		::ucasemap_utf8ToLower(map.get(), s.Get(), destLength, value.c_str(), sourceLength, &error);
-		Detail::AssertNoError(error, "ucasemap_utf8ToLower");
-		return {s.Get(), static_cast<size_t>(destLength)};
+		return Detail::MapCase(::ucasemap_utf8ToLower, "ucasemap_utf8ToLower", value, locale);
 	}
 
 	inline std::string ToUpper(const std::string & value, const char * locale = nullptr)
 	{
-		UErrorCode error = U_ZERO_ERROR;
-		auto map = Detail::MakeUCaseMap(locale); // cache
-
-		const auto sourceLength = static_cast<int32_t>(value.size());
-		const int32_t destLength = ::ucasemap_utf8ToUpper(map.get(), nullptr, 0, value.c_str(), sourceLength, &error);
-		Detail::AssertTrue(error == U_BUFFER_OVERFLOW_ERROR, "ucasemap_utf8ToUpper");
-
-		error = U_ZERO_ERROR;
-		Util::CharBuffer s;
-		s.EnsureSize(destLength);
-		::ucasemap_utf8ToUpper(map.get(), s.Get(), destLength, value.c_str(), sourceLength, &error);
-		Detail::AssertNoError(error, "ucasemap_utf8ToUpper");
-		return {s.Get(), static_cast<size_t>(destLength)};
+		return Detail::MapCase(::ucasemap_utf8ToUpper, "ucasemap_utf8ToUpper", value, locale);
+	}
+
+	// unicode simple case folding of one code point, independent of locale, one code point always folds to one
+	inline char32_t FoldCase(char32_t c)
+	{
+		return static_cast<char32_t>(::u_foldCase(static_cast<UChar32>(c), U_FOLD_CASE_DEFAULT));
+	}
+
+	// simple case folding of each code point, e.g. "\xC3\x89" and "\xC3\xA9" fold alike but "gro\xC3\x9F" and "GROSS" do not
+	// ill formed sequences are copied unchanged
+	inline std::string FoldCase(std::string_view value)
+	{
+		std::string result;
+		result.reserve(value.size());
+		const auto * bytes = reinterpret_cast<const uint8_t *>(value.data()); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast) ICU byte input
+		const auto length = static_cast<int32_t>(value.size());
+		for (int32_t index = 0; index < length;)
+		{
+			const int32_t start = index;
+			UChar32 codePoint {};
+			U8_NEXT(bytes, index, length, codePoint);
+			if (codePoint < 0)
+			{
+				result.append(value.substr(static_cast<size_t>(start), static_cast<size_t>(index - start)));
+				continue;
+			}
+
+			std::array<uint8_t, U8_MAX_LENGTH> folded {};
+			int32_t foldedLength {};
+			U8_APPEND_UNSAFE(folded.data(), foldedLength, static_cast<UChar32>(FoldCase(static_cast<char32_t>(codePoint))));
+			result.append(reinterpret_cast<const char *>(folded.data()), static_cast<size_t>(foldedLength)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast) ICU byte output
+		}
+		return result;
 	}
 }
\ No newline at end of file
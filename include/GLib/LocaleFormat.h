@@ -0,0 +1,416 @@
+#pragma once
+
+#include <GLib/cvt.h>
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstdio>
+#include <ctime>
+#include <iomanip>
+#include <limits>
+#include <locale>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace GLib::LocaleFormat
+{
+	namespace Detail
+	{
+		constexpr auto MonthCount = 12;
+		constexpr auto DayCount = 7;
+		constexpr auto DecimalBase = 10;
+
+		// locale symbols converted to utf8 once, wide facets are used as the narrow ones are not utf8 on windows
+		struct Names
+		{
+			std::array<std::string, MonthCount> shortMonths;
+			std::array<std::string, MonthCount> longMonths;
+			std::array<std::string, DayCount> shortDays;
+			std::array<std::string, DayCount> longDays;
+			std::array<std::string, 2> amPm;
+
+			std::string currencySymbol;
+			std::string positiveSign;
+			std::string negativeSign;
+			std::string decimalPoint;
+			std::string thousandsSeparator;
+			std::string grouping;
+			int fractionalDigits {};
+			std::money_base::pattern positiveFormat {};
+			std::money_base::pattern negativeFormat {};
+		};
+
+		inline std::string PutTime(std::wostringstream & stm, const std::tm & value, const wchar_t * format)
+		{
+			stm.str({});
+			stm << std::put_time(&value, format);
+			return Cvt::w2a(stm.str());
+		}
+
+		inline std::unique_ptr<Names> MakeNames(const std::locale & locale)
+		{
+			auto names = std::make_unique<Names>();
+
+			std::wostringstream stm;
+			(void) stm.imbue(locale);
+
+			std::tm tm {};
+			tm.tm_mday = 1;
+			for (int i = 0; i < MonthCount; ++i)
+			{
+				tm.tm_mon = i;
+				names->shortMonths[i] = PutTime(stm, tm, L"%b");
+				names->longMonths[i] = PutTime(stm, tm, L"%B");
+			}
+
+			for (int i = 0; i < DayCount; ++i)
+			{
+				tm.tm_wday = i;
+				names->shortDays[i] = PutTime(stm, tm, L"%a");
+				names->longDays[i] = PutTime(stm, tm, L"%A");
+			}
+
+			constexpr auto Noon = 12;
+			tm.tm_hour = 0;
+			names->amPm[0] = PutTime(stm, tm, L"%p");
+			tm.tm_hour = Noon;
+			names->amPm[1] = PutTime(stm, tm, L"%p");
+
+			const auto & punct = std::use_facet<std::moneypunct<wchar_t, false>>(locale);
+			names->currencySymbol = Cvt::w2a(punct.curr_symbol());
+			names->positiveSign = Cvt::w2a(punct.positive_sign());
+			names->negativeSign = Cvt::w2a(punct.negative_sign());
+			names->decimalPoint = Cvt::w2a(std::wstring(1, punct.decimal_point()));
+			names->thousandsSeparator = Cvt::w2a(std::wstring(1, punct.thousands_sep()));
+			names->grouping = punct.grouping();
+			names->fractionalDigits = punct.frac_digits();
+			names->positiveFormat = punct.pos_format();
+			names->negativeFormat = punct.neg_format();
+			return names;
+		}
+
+		inline void AppendNumber(std::string & out, long long value, int width, char pad = '0')
+		{
+			std::array<char, std::numeric_limits<long long>::digits10 + 2> buffer {};
+			auto it = buffer.end();
+			unsigned long long v = value < 0 ? 0ULL - static_cast<unsigned long long>(value) : static_cast<unsigned long long>(value);
+			do
+			{
+				*--it = static_cast<char>('0' + v % DecimalBase);
+				v /= DecimalBase;
+				--width;
+			} while (v != 0);
+
+			if (value < 0)
+			{
+				out += '-';
+			}
+			if (width > 0)
+			{
+				out.append(static_cast<size_t>(width), pad);
+			}
+			out.append(it, buffer.end());
+		}
+
+		// the first sign character is placed by the pattern, any remainder is appended at the end
+		inline size_t FirstCharacterLength(std::string_view value)
+		{
+			size_t length = value.empty() ? 0 : 1;
+			while (length < value.size() && (static_cast<unsigned char>(value[length]) & 0xC0U) == 0x80U) // NOLINT(readability-magic-numbers) utf8 continuation
+			{
+				++length;
+			}
+			return length;
+		}
+
+		inline void AppendGrouped(std::string & out, std::string_view digits, const Names & names)
+		{
+			if (names.grouping.empty() || names.thousandsSeparator.empty())
+			{
+				out += digits;
+				return;
+			}
+
+			// group sizes apply from the right, the last size repeats and CHAR_MAX or <=0 stops grouping
+			std::array<size_t, std::numeric_limits<long double>::max_exponent10 + 1> breaks {};
+			size_t breakCount {};
+			size_t pos = digits.size();
+			for (size_t g = 0; breakCount < breaks.size();)
+			{
+				const char size = names.grouping[g];
+				if (size <= 0 || size == CHAR_MAX || static_cast<size_t>(size) >= pos)
+				{
+					break;
+				}
+				pos -= static_cast<size_t>(size);
+				breaks[breakCount++] = pos;
+				if (g + 1 < names.grouping.size())
+				{
+					++g;
+				}
+			}
+
+			size_t start {};
+			while (breakCount != 0)
+			{
+				const size_t next = breaks[--breakCount];
+				out += digits.substr(start, next - start);
+				out += names.thousandsSeparator;
+				start = next;
+			}
+			out += digits.substr(start);
+		}
+	}
+
+	// cached per thread, by name for named locales and by the identity of the facets read for unnamed (combined) locales
+	inline const Detail::Names & GetNames(const std::locale & locale)
+	{
+		const std::string name = locale.name();
+		if (name == "*")
+		{
+			struct Unnamed
+			{
+				std::locale locale; // keeps the facets alive, so their addresses are not reused by another locale
+				const std::time_put<wchar_t> * time;
+				const std::moneypunct<wchar_t, false> * punct;
+				std::unique_ptr<Detail::Names> names;
+			};
+			constexpr auto MaxUnnamed = 16;
+
+			thread_local std::vector<Unnamed> unnamed;
+			const auto * time = &std::use_facet<std::time_put<wchar_t>>(locale);
+			const auto * punct = &std::use_facet<std::moneypunct<wchar_t, false>>(locale);
+			auto it = std::find_if(unnamed.begin(), unnamed.end(), [&](const Unnamed & u) { return u.time == time && u.punct == punct; });
+			if (it == unnamed.end())
+			{
+				if (unnamed.size() == MaxUnnamed)
+				{
+					unnamed.clear();
+				}
+				it = unnamed.insert(unnamed.end(), {locale, time, punct, Detail::MakeNames(locale)});
+			}
+			return *it->names;
+		}
+
+		thread_local std::unordered_map<std::string, std::unique_ptr<Detail::Names>> cache;
+		auto it = cache.find(name);
+		if (it == cache.end())
+		{
+			it = cache.emplace(name, Detail::MakeNames(locale)).first;
+		}
+		return *it->second;
+	}
+
+	// renders the common strftime specifiers directly as utf8, returns false if the format needs the full put_time implementation
+	inline bool FormatTime(std::string & out, const std::tm & value, std::string_view format, const std::locale & locale)
+	{
+		constexpr auto YearBase = 1900;
+		constexpr auto Century = 100;
+		constexpr auto HalfDay = 12;
+
+		if (value.tm_mon < 0 || value.tm_mon >= Detail::MonthCount || value.tm_wday < 0 || value.tm_wday >= Detail::DayCount)
+		{
+			return false;
+		}
+
+		const Detail::Names * names {};
+		auto localeNames = [&]() -> const Detail::Names & {
+			if (names == nullptr)
+			{
+				names = &GetNames(locale);
+			}
+			return *names;
+		};
+
+		const size_t start = out.size();
+		for (auto it = format.begin(), end = format.end(); it != end; ++it)
+		{
+			if (*it != '%')
+			{
+				out += *it;
+				continue;
+			}
+
+			if (++it == end)
+			{
+				out.resize(start);
+				return false;
+			}
+
+			const long long year = static_cast<long long>(value.tm_year) + YearBase;
+			switch (*it)
+			{
+				case 'a':
+					out += localeNames().shortDays[value.tm_wday];
+					break;
+				case 'A':
+					out += localeNames().longDays[value.tm_wday];
+					break;
+				case 'b':
+				case 'h':
+					out += localeNames().shortMonths[value.tm_mon];
+					break;
+				case 'B':
+					out += localeNames().longMonths[value.tm_mon];
+					break;
+				case 'p':
+					out += localeNames().amPm[value.tm_hour >= HalfDay ? 1 : 0];
+					break;
+				case 'C':
+					Detail::AppendNumber(out, year / Century, 2);
+					break;
+				case 'd':
+					Detail::AppendNumber(out, value.tm_mday, 2);
+					break;
+				case 'e':
+					Detail::AppendNumber(out, value.tm_mday, 2, ' ');
+					break;
+				case 'H':
+					Detail::AppendNumber(out, value.tm_hour, 2);
+					break;
+				case 'I':
+					Detail::AppendNumber(out, value.tm_hour % HalfDay == 0 ? HalfDay : value.tm_hour % HalfDay, 2);
+					break;
+				case 'j':
+					Detail::AppendNumber(out, value.tm_yday + 1, 3);
+					break;
+				case 'm':
+					Detail::AppendNumber(out, value.tm_mon + 1, 2);
+					break;
+				case 'M':
+					Detail::AppendNumber(out, value.tm_min, 2);
+					break;
+				case 'S':
+					Detail::AppendNumber(out, value.tm_sec, 2);
+					break;
+				case 'u':
+					Detail::AppendNumber(out, value.tm_wday == 0 ? Detail::DayCount : value.tm_wday, 1);
+					break;
+				case 'w':
+					Detail::AppendNumber(out, value.tm_wday, 1);
+					break;
+				case 'y':
+					Detail::AppendNumber(out, (year % Century + Century) % Century, 2);
+					break;
+				case 'Y':
+					Detail::AppendNumber(out, year, 1);
+					break;
+				case 'D':
+					Detail::AppendNumber(out, value.tm_mon + 1, 2);
+					out += '/';
+					Detail::AppendNumber(out, value.tm_mday, 2);
+					out += '/';
+					Detail::AppendNumber(out, (year % Century + Century) % Century, 2);
+					break;
+				case 'F':
+					Detail::AppendNumber(out, year, 4);
+					out += '-';
+					Detail::AppendNumber(out, value.tm_mon + 1, 2);
+					out += '-';
+					Detail::AppendNumber(out, value.tm_mday, 2);
+					break;
+				case 'R':
+				case 'T':
+					Detail::AppendNumber(out, value.tm_hour, 2);
+					out += ':';
+					Detail::AppendNumber(out, value.tm_min, 2);
+					if (*it == 'T')
+					{
+						out += ':';
+						Detail::AppendNumber(out, value.tm_sec, 2);
+					}
+					break;
+				case 'n':
+					out += '\n';
+					break;
+				case 't':
+					out += '\t';
+					break;
+				case '%':
+					out += '%';
+					break;
+				default:
+					out.resize(start);
+					return false;
+			}
+		}
+		return true;
+	}
+
+	// equivalent of put_money(value) with showbase, value is in the smallest currency unit, space is written as the stream's fill
+	inline void FormatMoney(std::string & out, long double value, const std::locale & locale, char fill = ' ')
+	{
+		const Detail::Names & names = GetNames(locale);
+
+		constexpr auto BufferSize = std::numeric_limits<long double>::max_exponent10 + 4;
+		std::array<char, BufferSize> buffer {};
+		const int len = ::snprintf(buffer.data(), buffer.size(), "%.0Lf", value); // NOLINT(cppcoreguidelines-pro-type-vararg,hicpp-vararg) by design
+		if (len <= 0 || static_cast<size_t>(len) >= buffer.size())
+		{
+			throw std::runtime_error("Money conversion failed");
+		}
+
+		std::string_view digits {buffer.data(), static_cast<size_t>(len)};
+		const bool negative = digits.front() == '-';
+		if (negative)
+		{
+			digits.remove_prefix(1);
+		}
+
+		const std::string & sign = negative ? names.negativeSign : names.positiveSign;
+		const size_t signLength = Detail::FirstCharacterLength(sign);
+		const std::money_base::pattern & pattern = negative ? names.negativeFormat : names.positiveFormat;
+
+		for (char field : pattern.field)
+		{
+			switch (static_cast<std::money_base::part>(field))
+			{
+				case std::money_base::symbol:
+					out += names.currencySymbol;
+					break;
+				case std::money_base::sign:
+					out += sign.substr(0, signLength);
+					break;
+				case std::money_base::space:
+					out += fill;
+					break;
+				case std::money_base::value:
+				{
+					const auto frac = static_cast<size_t>(names.fractionalDigits > 0 ? names.fractionalDigits : 0);
+					if (frac == 0)
+					{
+						Detail::AppendGrouped(out, digits, names);
+					}
+					else
+					{
+						// as per money_put, no leading zero is added for values less than one unit
+						if (digits.size() > frac)
+						{
+							Detail::AppendGrouped(out, digits.substr(0, digits.size() - frac), names);
+						}
+						out += names.decimalPoint;
+						if (digits.size() < frac)
+						{
+							out.append(frac - digits.size(), '0');
+						}
+						out += digits.substr(digits.size() > frac ? digits.size() - frac : 0);
+					}
+					break;
+				}
+				case std::money_base::none:
+				default:
+					break;
+			}
+		}
+
+		if (sign.size() > signLength)
+		{
+			out += sign.substr(signLength);
+		}
+	}
+}
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <GLib/IcuUtils.h>
+#include <GLib/Utf8Validator.h>
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+
+#ifdef __linux__
+#include <unicode/unorm2.h>
+#include <unicode/ustring.h>
+#endif
+
+namespace GLib::IcuUtils
+{
+	namespace Detail
+	{
+		inline const UNormalizer2 * Nfc()
+		{
+			UErrorCode error = U_ZERO_ERROR;
+			const UNormalizer2 * nfc = ::unorm2_getNFCInstance(&error);
+			AssertNoError(error, "unorm2_getNFCInstance");
+			return nfc;
+		}
+
+		using UCharBuffer = Util::StackOrHeap<UChar, Util::DefaultStackReserveSize>;
+
+		inline int32_t ToUtf16(std::string_view value, UCharBuffer & buffer)
+		{
+			UErrorCode error = U_ZERO_ERROR;
+			int32_t length {};
+			::u_strFromUTF8(buffer.Get(), static_cast<int32_t>(buffer.size()), &length, value.data(), static_cast<int32_t>(value.size()), &error);
+			if (error == U_BUFFER_OVERFLOW_ERROR)
+			{
+				error = U_ZERO_ERROR;
+				buffer.EnsureSize(static_cast<size_t>(length));
+				::u_strFromUTF8(buffer.Get(), length, &length, value.data(), static_cast<int32_t>(value.size()), &error);
+			}
+			AssertNoError(error, "u_strFromUTF8");
+			return length;
+		}
+
+		inline void AppendUtf8(std::string & out, const UChar * value, int32_t length)
+		{
+			const size_t start = out.size();
+			// at most three utf8 bytes per utf16 unit
+			out.resize(start + static_cast<size_t>(length) * 3);
+			UErrorCode error = U_ZERO_ERROR;
+			int32_t written {};
+			::u_strToUTF8(out.data() + start, static_cast<int32_t>(out.size() - start), &written, value, length, &error); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) resized above
+			AssertNoError(error, "u_strToUTF8");
+			out.resize(start + static_cast<size_t>(written));
+		}
+
+		// appends valid utf8 in NFC, text that is already NFC (the common case) is appended as it is
+		inline void AppendNfc(std::string & out, std::string_view value)
+		{
+			if (Util::FindFirstNotOf(value, Util::Detail::AsciiBytes()) == std::string_view::npos)
+			{
+				out += value;
+				return;
+			}
+
+			const UNormalizer2 * nfc = Nfc();
+			UCharBuffer source;
+			const int32_t length = ToUtf16(value, source);
+
+			UErrorCode error = U_ZERO_ERROR;
+			const int32_t normalised = ::unorm2_spanQuickCheckYes(nfc, source.Get(), length, &error);
+			AssertNoError(error, "unorm2_spanQuickCheckYes");
+			if (normalised == length)
+			{
+				out += value;
+				return;
+			}
+
+			UCharBuffer dest;
+			int32_t destLength = ::unorm2_normalize(nfc, source.Get(), length, dest.Get(), static_cast<int32_t>(dest.size()), &error);
+			if (error == U_BUFFER_OVERFLOW_ERROR)
+			{
+				error = U_ZERO_ERROR;
+				dest.EnsureSize(static_cast<size_t>(destLength));
+				destLength = ::unorm2_normalize(nfc, source.Get(), length, dest.Get(), destLength, &error);
+			}
+			AssertNoError(error, "unorm2_normalize");
+			AppendUtf8(out, dest.Get(), destLength);
+		}
+
+		// start of the last code point that begins a new normalisation segment, text before it is unaffected by what follows
+		inline size_t LastNfcBoundary(std::string_view value)
+		{
+			constexpr unsigned char ContinuationTagMask = 0xC0;
+			constexpr unsigned char ContinuationTag = 0x80;
+
+			const UNormalizer2 * nfc = Nfc();
+			const auto * bytes = reinterpret_cast<const uint8_t *>(value.data()); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast) ICU byte input
+			for (size_t i = value.size(); i-- != 0;)
+			{
+				const auto c = static_cast<unsigned char>(value[i]);
+				if ((c & ContinuationTagMask) == ContinuationTag)
+				{
+					continue;
+				}
+
+				UChar32 codePoint {};
+				auto index = static_cast<int32_t>(i);
+				U8_NEXT(bytes, index, static_cast<int32_t>(value.size()), codePoint);
+				if (codePoint >= 0 && ::unorm2_hasBoundaryBefore(nfc, codePoint) != FALSE)
+				{
+					return i;
+				}
+			}
+			return 0;
+		}
+	}
+
+	// validates utf8 written in chunks of any size and appends it to out in NFC, e.g. as input to Xml::Holder or Cpp::Holder
+	// chunks of ascii are validated by the vectorised scan and appended directly, only others go through ICU
+	// the text after the last normalisation boundary is held back until the next write or Finish
+	class NfcWriter
+	{
+		std::string & out;
+		Util::Utf8Validator validator;
+		std::string pending;
+		std::string segment;
+
+	public:
+		explicit NfcWriter(std::string & out)
+			: out(out)
+		{}
+
+		void Write(std::string_view chunk)
+		{
+			const size_t invalid = validator.Feed(chunk);
+			if (invalid != std::string_view::npos)
+			{
+				throw std::runtime_error("Invalid UTF-8 at offset " + std::to_string(invalid));
+			}
+
+			// an incomplete sequence at the end is held back with the segment it belongs to
+			const std::string_view complete = chunk.substr(0, chunk.size() - std::min(validator.Pending(), chunk.size()));
+			if (pending.empty() && !complete.empty() && Util::FindFirstNotOf(complete, Util::Detail::AsciiBytes()) == std::string_view::npos)
+			{
+				// a following combining mark can still compose with the last character
+				out += complete.substr(0, complete.size() - 1);
+				pending.assign(chunk.substr(complete.size() - 1));
+				return;
+			}
+
+			segment.assign(pending).append(chunk);
+			const std::string_view value {segment.data(), segment.size() - validator.Pending()};
+			const size_t boundary = Detail::LastNfcBoundary(value);
+			Detail::AppendNfc(out, value.substr(0, boundary));
+			pending.assign(segment, boundary);
+		}
+
+		void Finish()
+		{
+			const size_t truncated = validator.Finish();
+			if (truncated != std::string_view::npos)
+			{
+				throw std::runtime_error("Truncated UTF-8 at offset " + std::to_string(truncated));
+			}
+
+			Detail::AppendNfc(out, pending);
+			pending.clear();
+		}
+	};
+
+	inline std::string ToNfc(std::string_view value)
+	{
+		std::string result;
+		NfcWriter writer {result};
+		writer.Write(value);
+		writer.Finish();
+		return result;
+	}
+}
@@ -30,10 +30,25 @@ namespace GLib
 		size_t operator()(const std::string & key) const
 		{
 			size_t val {};
-			for (char c : IcuUtils::ToLower(key))
+			auto hash = [&](char c)
 			{
 				val ^= static_cast<size_t>(c);
 				val *= fnvPrime;
+			};
+
+			if (IcuUtils::CanFoldAscii(key))
+			{
+				for (char c : key)
+				{
+					hash(IcuUtils::ToLowerAscii(c));
+				}
+			}
+			else
+			{
+				for (char c : IcuUtils::ToLower(key))
+				{
+					hash(c);
+				}
 			}
 			return val;
 		}
@@ -0,0 +1,324 @@
+#pragma once
+
+#include <GLib/IcuUtils.h>
+#include <GLib/Utf8Validator.h>
+#include <GLib/cvt.h>
+
+#include <algorithm>
+#include <deque>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace GLib
+{
+	namespace Detail
+	{
+		template <typename CharType>
+		struct NoCaseFold;
+
+		// utf8 keys use unicode simple case folding of each code point, "\xC3\x89" matches "\xC3\xA9" but "gro\xC3\x9F" not "GROSS"
+		// ascii keys are folded a byte at a time, other text is decoded to fold each code point
+		template <>
+		struct NoCaseFold<char>
+		{
+			static bool FoldsPerCharacter(std::string_view value)
+			{
+				return Util::FindFirstNotOf(value, Util::Detail::AsciiBytes()) == std::string_view::npos;
+			}
+
+			static char FoldCharacter(char c)
+			{
+				return IcuUtils::ToLowerAscii(c);
+			}
+
+			static std::string Fold(std::string_view value)
+			{
+				return IcuUtils::FoldCase(value);
+			}
+		};
+
+		// wide keys fold only A-Z as _wcsicmp does in the C locale, so the map agrees with CaseInsensitiveMap<wchar_t> e.g. in Coverage
+		// each character folds to one character, so no key needs a folded string to be built for a lookup
+		template <>
+		struct NoCaseFold<wchar_t>
+		{
+			static bool FoldsPerCharacter(std::wstring_view /*value*/)
+			{
+				return true;
+			}
+
+			static wchar_t FoldCharacter(wchar_t c)
+			{
+				return c >= L'A' && c <= L'Z' ? static_cast<wchar_t>(c - L'A' + L'a') : c;
+			}
+
+			static std::wstring Fold(std::wstring_view value)
+			{
+				std::wstring folded(value.size(), L'\0');
+				std::transform(value.begin(), value.end(), folded.begin(), FoldCharacter);
+				return folded;
+			}
+		};
+	}
+
+	// insert only map with case insensitive keys, for keys such as file names that are added once and looked up many times
+	// each key is folded once on insert, a lookup folds the probe key once (ascii and wide keys without allocating) and compares folded keys by value
+	// the open addressing table holds the hash and entry index, entries are kept in insertion order with stable references
+	template <typename CharType, typename Value>
+	class NoCaseFlatMap
+	{
+	public:
+		using key_type = std::basic_string<CharType>;
+		using mapped_type = Value;
+		using value_type = std::pair<const key_type, Value>;
+		using iterator = typename std::deque<value_type>::iterator;
+		using const_iterator = typename std::deque<value_type>::const_iterator;
+
+	private:
+		using View = std::basic_string_view<CharType>;
+		using Fold = Detail::NoCaseFold<CharType>;
+
+		static constexpr size_t Empty = std::numeric_limits<size_t>::max();
+		static constexpr size_t MinBuckets = 16;
+		static constexpr size_t fnvPrime = 16777619U;
+
+		struct Bucket
+		{
+			size_t hash;
+			size_t index;
+		};
+
+		std::deque<value_type> entries;
+		std::vector<key_type> foldedKeys;
+		std::vector<Bucket> buckets;
+
+		// folded key of the probe, only built for keys that are not folded a character at a time
+		struct Probe
+		{
+			View key;
+			bool perCharacter;
+			key_type folded;
+			size_t hash;
+		};
+
+		static size_t Hash(View folded)
+		{
+			size_t val {};
+			for (CharType c : folded)
+			{
+				val ^= static_cast<size_t>(c);
+				val *= fnvPrime;
+			}
+			return val;
+		}
+
+		static Probe MakeProbe(View key)
+		{
+			Probe probe {key, Fold::FoldsPerCharacter(key), {}, {}};
+			if (probe.perCharacter)
+			{
+				size_t val {};
+				for (CharType c : key)
+				{
+					val ^= static_cast<size_t>(Fold::FoldCharacter(c));
+					val *= fnvPrime;
+				}
+				probe.hash = val;
+			}
+			else
+			{
+				probe.folded = Fold::Fold(key);
+				probe.hash = Hash(probe.folded);
+			}
+			return probe;
+		}
+
+		static bool Matches(const Probe & probe, const key_type & folded)
+		{
+			if (!probe.perCharacter)
+			{
+				return probe.folded == folded;
+			}
+			return probe.key.size() == folded.size()
+				&& std::equal(probe.key.begin(), probe.key.end(), folded.begin(), [](CharType c, CharType f) { return Fold::FoldCharacter(c) == f; });
+		}
+
+		size_t Mask() const
+		{
+			return buckets.size() - 1;
+		}
+
+		// bucket holding the probe key or the empty bucket where it would be inserted
+		size_t FindBucket(const Probe & probe) const
+		{
+			for (size_t i = probe.hash & Mask();; i = (i + 1) & Mask())
+			{
+				const Bucket & bucket = buckets[i];
+				if (bucket.index == Empty || (bucket.hash == probe.hash && Matches(probe, foldedKeys[bucket.index])))
+				{
+					return i;
+				}
+			}
+		}
+
+		size_t FindIndex(View key) const
+		{
+			return entries.empty() ? Empty : buckets[FindBucket(MakeProbe(key))].index;
+		}
+
+		void Rehash(size_t bucketCount)
+		{
+			std::vector<Bucket> rehashed(bucketCount, Bucket {0, Empty});
+			const size_t mask = bucketCount - 1;
+			for (const Bucket & bucket : buckets)
+			{
+				if (bucket.index != Empty)
+				{
+					size_t i = bucket.hash & mask;
+					while (rehashed[i].index != Empty)
+					{
+						i = (i + 1) & mask;
+					}
+					rehashed[i] = bucket;
+				}
+			}
+			buckets = std::move(rehashed);
+		}
+
+		static size_t BucketCount(size_t size)
+		{
+			// load factor at most 3/4 keeps probe sequences short
+			size_t count = MinBuckets;
+			while (count / 4 * 3 < size)
+			{
+				count *= 2;
+			}
+			return count;
+		}
+
+		void Grow()
+		{
+			if (buckets.empty() || (entries.size() + 1) > buckets.size() / 4 * 3)
+			{
+				Rehash(BucketCount(entries.size() + 1));
+			}
+		}
+
+	public:
+		NoCaseFlatMap() = default;
+
+		NoCaseFlatMap(std::initializer_list<std::pair<View, Value>> values)
+		{
+			reserve(values.size());
+			for (const auto & [key, value] : values)
+			{
+				try_emplace(key, value);
+			}
+		}
+
+		size_t size() const noexcept
+		{
+			return entries.size();
+		}
+
+		bool empty() const noexcept
+		{
+			return entries.empty();
+		}
+
+		iterator begin() noexcept
+		{
+			return entries.begin();
+		}
+
+		iterator end() noexcept
+		{
+			return entries.end();
+		}
+
+		const_iterator begin() const noexcept
+		{
+			return entries.begin();
+		}
+
+		const_iterator end() const noexcept
+		{
+			return entries.end();
+		}
+
+		void reserve(size_t count)
+		{
+			if (BucketCount(count) > buckets.size())
+			{
+				Rehash(BucketCount(count));
+			}
+		}
+
+		void clear() noexcept
+		{
+			entries.clear();
+			foldedKeys.clear();
+			buckets.clear();
+		}
+
+		iterator find(View key)
+		{
+			const size_t index = FindIndex(key);
+			return index == Empty ? end() : entries.begin() + static_cast<std::ptrdiff_t>(index);
+		}
+
+		const_iterator find(View key) const
+		{
+			const size_t index = FindIndex(key);
+			return index == Empty ? end() : entries.begin() + static_cast<std::ptrdiff_t>(index);
+		}
+
+		size_t count(View key) const
+		{
+			return find(key) == end() ? 0 : 1;
+		}
+
+		// the key is stored as first inserted, later keys that differ only in case find the same entry
+		template <typename... Args>
+		std::pair<iterator, bool> try_emplace(View key, Args &&... args)
+		{
+			Grow();
+			Probe probe = MakeProbe(key);
+			Bucket & bucket = buckets[FindBucket(probe)];
+			if (bucket.index != Empty)
+			{
+				return {entries.begin() + static_cast<std::ptrdiff_t>(bucket.index), false};
+			}
+
+			key_type folded = probe.perCharacter ? key_type(key.size(), CharType {}) : std::move(probe.folded);
+			if (probe.perCharacter)
+			{
+				std::transform(key.begin(), key.end(), folded.begin(), Fold::FoldCharacter);
+			}
+
+			entries.emplace_back(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+			try
+			{
+				foldedKeys.push_back(std::move(folded));
+			}
+			catch (...)
+			{
+				entries.pop_back();
+				throw;
+			}
+			bucket = {probe.hash, entries.size() - 1};
+			return {std::prev(entries.end()), true};
+		}
+
+		Value & operator[](View key)
+		{
+			return try_emplace(key).first->second;
+		}
+	};
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <GLib/split.h>
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace GLib::Util
+{
+	namespace Detail
+	{
+		constexpr size_t MinParallelChunkSize = 1024 * 1024;
+
+		// a delimiter that can overlap itself ("aa", "abab") has matches that depend on where the search starts
+		inline bool SelfOverlapping(std::string_view delimiter)
+		{
+			for (size_t length = 1; length < delimiter.size(); ++length)
+			{
+				if (delimiter.substr(0, length) == delimiter.substr(delimiter.size() - length))
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		inline size_t ChunkCount(std::string_view value, std::string_view delimiter, size_t chunkCount)
+		{
+			if (SelfOverlapping(delimiter))
+			{
+				return 1;
+			}
+			if (chunkCount == 0)
+			{
+				chunkCount = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1U), value.size() / MinParallelChunkSize);
+			}
+			return std::clamp<size_t>(chunkCount, 1, std::max<size_t>(value.size(), 1));
+		}
+
+		// each chunk, other than the last, ends just before a delimiter so that the tokens match a sequential split
+		inline std::vector<std::string_view> Chunks(std::string_view value, std::string_view delimiter, size_t chunkCount)
+		{
+			std::vector<std::string_view> chunks;
+			size_t start {};
+			for (size_t i = 1; i < chunkCount; ++i)
+			{
+				const size_t end = value.find(delimiter, std::max(start, value.size() / chunkCount * i));
+				if (end == std::string_view::npos)
+				{
+					break;
+				}
+				chunks.push_back(value.substr(start, end - start));
+				start = end + delimiter.size();
+			}
+			chunks.push_back(value.substr(start));
+			return chunks;
+		}
+
+		// one worker per hardware thread takes the next chunk until none are left, so a large chunkCount does not start a thread per chunk
+		template <typename Callback>
+		void SplitChunks(const std::vector<std::string_view> & chunks, std::string_view delimiter, Callback & callback)
+		{
+			std::atomic<size_t> next {};
+			auto worker = [&]()
+			{
+				try
+				{
+					for (size_t index = next++; index < chunks.size(); index = next++)
+					{
+						for (auto token : SplitterView {NonOwning, chunks[index], delimiter})
+						{
+							callback(index, token);
+						}
+					}
+				}
+				catch (...)
+				{
+					next = chunks.size(); // the other workers stop after their current chunk
+					throw;
+				}
+			};
+
+			const size_t workerCount = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1U), chunks.size());
+			std::vector<std::future<void>> futures;
+			futures.reserve(workerCount - 1);
+			for (size_t i = 1; i < workerCount; ++i)
+			{
+				futures.push_back(std::async(std::launch::async, worker));
+			}
+
+			// any futures not yet waited for are waited for on destruction before an exception leaves
+			worker();
+			for (auto & future : futures)
+			{
+				future.get();
+			}
+		}
+	}
+
+	// splits chunks of value concurrently calling callback(size_t chunkIndex, std::string_view token) on the thread splitting that chunk
+	// tokens within a chunk are in order, in chunk order they are the same as SplitterView with the same delimiter
+	// chunkCount 0 uses one chunk per hardware thread for large values, at most one thread per hardware thread splits the chunks
+	// exceptions from the callback are rethrown
+	template <typename Callback>
+	void ParallelSplitEach(std::string_view value, std::string_view delimiter, Callback callback, size_t chunkCount = 0)
+	{
+		if (delimiter.empty())
+		{
+			throw std::logic_error("Delimiter is empty");
+		}
+
+		Detail::SplitChunks(Detail::Chunks(value, delimiter, Detail::ChunkCount(value, delimiter, chunkCount)), delimiter, callback);
+	}
+
+	// tokens per chunk, joined in order they are the same as SplitterView with the same delimiter
+	inline std::vector<std::vector<std::string_view>> ParallelSplit(std::string_view value, std::string_view delimiter = ",",
+																																	size_t chunkCount = 0)
+	{
+		if (delimiter.empty())
+		{
+			throw std::logic_error("Delimiter is empty");
+		}
+
+		const std::vector<std::string_view> chunks = Detail::Chunks(value, delimiter, Detail::ChunkCount(value, delimiter, chunkCount));
+		std::vector<std::vector<std::string_view>> result(chunks.size());
+		auto append = [&](size_t index, std::string_view token) { result[index].push_back(token); };
+		Detail::SplitChunks(chunks, delimiter, append);
+		return result;
+	}
+}
@@ -0,0 +1,271 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+namespace GLib::Util
+{
+	namespace Detail
+	{
+		constexpr uint64_t FnvOffsetBasis = 14695981039346656037ULL;
+		constexpr uint64_t FnvPrime = 1099511628211ULL;
+		constexpr uint64_t GoldenRatio = 0x9e3779b97f4a7c15ULL;
+		constexpr uint32_t MaxSeed = 1U << 16U;
+
+		// eight characters at a time, the loads are assembled from bytes to stay constexpr which the compiler folds into one load
+		constexpr uint64_t PerfectHashKey(std::string_view value) noexcept
+		{
+			constexpr size_t wordSize = sizeof(uint64_t);
+			constexpr unsigned int bitsPerChar = 8;
+
+			uint64_t hash = FnvOffsetBasis ^ value.size();
+			for (size_t pos = 0; pos < value.size(); pos += wordSize)
+			{
+				uint64_t word {};
+				if (value.size() - pos >= wordSize)
+				{
+					for (size_t i = 0; i < wordSize; ++i)
+					{
+						word |= static_cast<uint64_t>(static_cast<unsigned char>(value[pos + i])) << (i * bitsPerChar);
+					}
+				}
+				else
+				{
+					for (size_t i = 0; i < value.size() - pos; ++i)
+					{
+						word |= static_cast<uint64_t>(static_cast<unsigned char>(value[pos + i])) << (i * bitsPerChar);
+					}
+				}
+				hash = (hash ^ word) * FnvPrime;
+			}
+			return hash;
+		}
+
+		// splitmix64 finaliser, a different seed gives an independent slot for the same key hash
+		constexpr uint64_t PerfectHashMix(uint64_t hash, uint32_t seed) noexcept
+		{
+			constexpr unsigned int shift1 = 30;
+			constexpr unsigned int shift2 = 27;
+			constexpr unsigned int shift3 = 31;
+			constexpr uint64_t multiplier1 = 0xbf58476d1ce4e5b9ULL;
+			constexpr uint64_t multiplier2 = 0x94d049bb133111ebULL;
+
+			uint64_t value = hash + GoldenRatio * seed;
+			value = (value ^ (value >> shift1)) * multiplier1;
+			value = (value ^ (value >> shift2)) * multiplier2;
+			return value ^ (value >> shift3);
+		}
+
+		constexpr size_t PowerOfTwoAtLeast(size_t value) noexcept
+		{
+			size_t result = 1;
+			while (result < value)
+			{
+				result *= 2;
+			}
+			return result;
+		}
+
+		// hash and displace: keys are grouped into buckets by their hash, each bucket has a seed chosen at compile time
+		// that places all its keys in free slots, so a lookup is one hash of the key, one mix and one key compare
+		template <size_t N>
+		class PerfectHashIndex
+		{
+			static_assert(N != 0, "No keys");
+
+			static constexpr size_t Buckets = PowerOfTwoAtLeast(N);
+			static constexpr size_t Slots = PowerOfTwoAtLeast(N * 2);
+			static constexpr auto EmptySlot = static_cast<uint32_t>(N);
+
+			std::array<uint32_t, Buckets> seeds {};
+			std::array<uint32_t, Slots> slots {};
+
+		public:
+			explicit constexpr PerfectHashIndex(const std::array<std::string_view, N> & keys)
+			{
+				std::array<uint64_t, N> hashes {};
+				std::array<size_t, Buckets> bucketSizes {};
+				size_t maxBucketSize {};
+				for (size_t i = 0; i < N; ++i)
+				{
+					hashes[i] = PerfectHashKey(keys[i]);
+					for (size_t j = 0; j < i; ++j)
+					{
+						if (keys[i] == keys[j])
+						{
+							throw std::logic_error("Duplicate key");
+						}
+					}
+					const size_t size = ++bucketSizes[hashes[i] & (Buckets - 1)];
+					maxBucketSize = size > maxBucketSize ? size : maxBucketSize;
+				}
+
+				for (auto & slot : slots)
+				{
+					slot = EmptySlot;
+				}
+
+				// largest buckets first while most slots are free
+				for (size_t size = maxBucketSize; size != 0; --size)
+				{
+					for (size_t bucket = 0; bucket < Buckets; ++bucket)
+					{
+						if (bucketSizes[bucket] == size)
+						{
+							PlaceBucket(bucket, hashes);
+						}
+					}
+				}
+			}
+
+			// index of the only key that can match, or N
+			constexpr size_t Find(std::string_view key) const noexcept
+			{
+				const uint64_t hash = PerfectHashKey(key);
+				return slots[Slot(hash, seeds[hash & (Buckets - 1)])];
+			}
+
+		private:
+			static constexpr size_t Slot(uint64_t hash, uint32_t seed) noexcept
+			{
+				return static_cast<size_t>(PerfectHashMix(hash, seed) & (Slots - 1));
+			}
+
+			constexpr void PlaceBucket(size_t bucket, const std::array<uint64_t, N> & hashes)
+			{
+				for (uint32_t seed = 0; seed != MaxSeed; ++seed)
+				{
+					if (Fits(bucket, seed, hashes))
+					{
+						seeds[bucket] = seed;
+						for (size_t i = 0; i < N; ++i)
+						{
+							if ((hashes[i] & (Buckets - 1)) == bucket)
+							{
+								slots[Slot(hashes[i], seed)] = static_cast<uint32_t>(i);
+							}
+						}
+						return;
+					}
+				}
+				throw std::logic_error("No perfect hash seed found");
+			}
+
+			constexpr bool Fits(size_t bucket, uint32_t seed, const std::array<uint64_t, N> & hashes) const
+			{
+				for (size_t i = 0; i < N; ++i)
+				{
+					if ((hashes[i] & (Buckets - 1)) != bucket)
+					{
+						continue;
+					}
+					const size_t slot = Slot(hashes[i], seed);
+					if (slots[slot] != EmptySlot)
+					{
+						return false;
+					}
+					for (size_t j = 0; j < i; ++j)
+					{
+						if ((hashes[j] & (Buckets - 1)) == bucket && Slot(hashes[j], seed) == slot)
+						{
+							return false;
+						}
+					}
+				}
+				return true;
+			}
+		};
+
+		template <typename T, size_t N, size_t... I>
+		constexpr std::array<T, N> ToArray(const T (&values)[N], std::index_sequence<I...> /*unused*/) // NOLINT(cppcoreguidelines-avoid-c-arrays,hicpp-avoid-c-arrays,modernize-avoid-c-arrays)
+		{
+			return {{values[I]...}};
+		}
+	}
+
+	// collision free set of string literals built at compile time, e.g. for classifying identifiers
+	// constexpr auto keywords = Util::MakePerfectHashSet({"if", "else", "while"});
+	template <size_t N>
+	class PerfectHashSet
+	{
+		std::array<std::string_view, N> keys;
+		Detail::PerfectHashIndex<N> index;
+
+	public:
+		explicit constexpr PerfectHashSet(const std::array<std::string_view, N> & keys)
+			: keys(keys)
+			, index(keys)
+		{}
+
+		constexpr bool contains(std::string_view key) const noexcept
+		{
+			const size_t i = index.Find(key);
+			return i != N && keys[i] == key;
+		}
+
+		static constexpr size_t size() noexcept
+		{
+			return N;
+		}
+	};
+
+	// as PerfectHashSet with a value for each key
+	template <typename Value, size_t N>
+	class PerfectHashMap
+	{
+	public:
+		using value_type = std::pair<std::string_view, Value>;
+
+	private:
+		std::array<value_type, N> entries;
+		Detail::PerfectHashIndex<N> index;
+
+		static constexpr std::array<std::string_view, N> Keys(const std::array<value_type, N> & entries)
+		{
+			std::array<std::string_view, N> keys {};
+			for (size_t i = 0; i < N; ++i)
+			{
+				keys[i] = entries[i].first;
+			}
+			return keys;
+		}
+
+	public:
+		explicit constexpr PerfectHashMap(const std::array<value_type, N> & entries)
+			: entries(entries)
+			, index(Keys(entries))
+		{}
+
+		// nullptr if not found
+		constexpr const Value * find(std::string_view key) const noexcept
+		{
+			const size_t i = index.Find(key);
+			return i != N && entries[i].first == key ? &entries[i].second : nullptr;
+		}
+
+		constexpr bool contains(std::string_view key) const noexcept
+		{
+			return find(key) != nullptr;
+		}
+
+		static constexpr size_t size() noexcept
+		{
+			return N;
+		}
+	};
+
+	template <size_t N>
+	constexpr PerfectHashSet<N> MakePerfectHashSet(const std::string_view (&keys)[N]) // NOLINT(cppcoreguidelines-avoid-c-arrays,hicpp-avoid-c-arrays,modernize-avoid-c-arrays)
+	{
+		return PerfectHashSet<N> {Detail::ToArray(keys, std::make_index_sequence<N> {})};
+	}
+
+	template <typename Value, size_t N>
+	constexpr PerfectHashMap<Value, N> MakePerfectHashMap(const std::pair<std::string_view, Value> (&entries)[N]) // NOLINT(cppcoreguidelines-avoid-c-arrays,hicpp-avoid-c-arrays,modernize-avoid-c-arrays)
+	{
+		return PerfectHashMap<Value, N> {Detail::ToArray(entries, std::make_index_sequence<N> {})};
+	}
+}
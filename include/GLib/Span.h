@@ -3,32 +3,35 @@
 #include <cstddef>
 #include <iterator>
 #include <stdexcept>
+#include <type_traits>
 
 namespace GLib
 {
-	template <typename T>
+	// contiguous view, Span<T> is read only and MutableSpan<T> allows the elements to be assigned
+	// iterators are plain pointers so std algorithms can use memcpy and vectorise
+	// operator[] is unchecked as std::span and the same in every build, at() and slicing are always checked
+	template <typename T, typename Element = const T>
 	class Span
 	{
 	public:
-		class Iterator;
-
-		using element_type = T;
+		using element_type = Element;
 		using value_type = std::remove_cv_t<T>;
 		using index_type = std::ptrdiff_t;
-		using pointer = const element_type *;
-		using reference = const element_type &;
+		using pointer = element_type *;
+		using reference = element_type &;
 		using size_type = index_type;
-		using iterator = Iterator;
+		using iterator = pointer;
+		using reverse_iterator = std::reverse_iterator<iterator>;
 
 	private:
-		const T * ptr {};
-		size_type size {};
+		pointer ptr {};
+		size_type count {};
 
 	public:
 		constexpr Span() noexcept = default;
 		constexpr Span(pointer ptr, size_type size)
 			: ptr {ptr}
-			, size {size}
+			, count {size}
 		{
 			if (size < 0)
 			{
@@ -36,87 +39,113 @@ namespace GLib
 			}
 		}
 
-		constexpr Iterator begin() const
+		// MutableSpan to Span
+		template <typename Other, typename = std::enable_if_t<std::is_const_v<Element> && std::is_same_v<Other, T>>>
+		constexpr Span(const Span<T, Other> & other) noexcept // NOLINT(google-explicit-constructor,hicpp-explicit-conversions) as std::span
+			: ptr {other.data()}
+			, count {other.size()}
+		{}
+
+		constexpr size_type size() const noexcept
 		{
-			return {ptr, size};
+			return count;
 		}
 
-		constexpr Iterator end() const
+		constexpr bool empty() const noexcept
 		{
-			return {};
+			return count == 0;
 		}
 
-		constexpr reference operator[](index_type idx) const
+		constexpr pointer data() const noexcept
 		{
-			if (idx >= size || idx < 0)
-			{
-				throw std::logic_error("IndexOutOfRange");
-			}
-			return ptr[idx]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) until c++20 span
+			return ptr;
 		}
 
-		class Iterator
+		constexpr iterator begin() const noexcept
 		{
-		public:
-			using iterator_category = std::random_access_iterator_tag;
-			using value_type = typename Span::value_type;
-			using difference_type = typename Span::index_type;
-			using pointer = const value_type *;
-			using reference = const value_type &;
+			return ptr;
+		}
 
-		private:
-			pointer ptr = {};
-			pointer end = {};
+		constexpr iterator end() const noexcept
+		{
+			return ptr + count; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) until c++20 span
+		}
 
-		public:
-			constexpr Iterator() noexcept = default;
+		constexpr reverse_iterator rbegin() const noexcept
+		{
+			return reverse_iterator {end()};
+		}
 
-			constexpr Iterator(pointer ptr, size_type size) noexcept
-				: ptr {ptr}
-				, end {ptr + size}
-			{}
+		constexpr reverse_iterator rend() const noexcept
+		{
+			return reverse_iterator {begin()};
+		}
 
-			constexpr bool operator==(const Iterator & other) const
-			{
-				return ptr == other.ptr;
-			}
+		constexpr reference operator[](index_type idx) const
+		{
+			return ptr[idx]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) until c++20 span
+		}
 
-			constexpr bool operator!=(const Iterator & it) const
-			{
-				return !(*this == it);
-			}
+		constexpr reference at(index_type idx) const
+		{
+			CheckIndex(idx);
+			return ptr[idx]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) until c++20 span
+		}
 
-			constexpr Iterator & operator++()
-			{
-				if (++ptr == end)
-				{
-					ptr = nullptr;
-				}
-				return *this;
-			}
+		constexpr Span first(size_type size) const
+		{
+			CheckSlice(0, size);
+			return Span {ptr, size};
+		}
 
-			constexpr Iterator operator++(int) // NOLINT(cert-dcl21-cpp) 'operator++' returns a non-constant object but constexpr is const
-			{
-				Iterator it {*this};
-				++(*this);
-				return it;
-			}
+		constexpr Span last(size_type size) const
+		{
+			CheckSlice(count - size, size);
+			return Span {ptr + (count - size), size}; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) until c++20 span
+		}
+
+		// the elements from offset to the end
+		constexpr Span subspan(index_type offset) const
+		{
+			return subspan(offset, count - offset);
+		}
+
+		constexpr Span subspan(index_type offset, size_type size) const
+		{
+			CheckSlice(offset, size);
+			return Span {ptr + offset, size}; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) until c++20 span
+		}
 
-			constexpr reference operator*() const
+	private:
+		constexpr void CheckIndex(index_type idx) const
+		{
+			if (idx >= count || idx < 0)
 			{
-				return *ptr;
+				throw std::logic_error("IndexOutOfRange");
 			}
+		}
 
-			constexpr pointer operator->() const
+		constexpr void CheckSlice(index_type offset, size_type size) const
+		{
+			if (offset < 0 || size < 0 || offset > count || size > count - offset)
 			{
-				return ptr;
+				throw std::logic_error("SliceOutOfRange");
 			}
-		};
+		}
 	};
 
+	template <typename T>
+	using MutableSpan = Span<T, T>;
+
 	template <typename T>
 	Span<T> MakeSpan(const T * value, size_t size)
 	{
 		return Span<T> {value, static_cast<std::ptrdiff_t>(size)};
 	}
-}
\ No newline at end of file
+
+	template <typename T>
+	MutableSpan<T> MakeMutableSpan(T * value, size_t size)
+	{
+		return MutableSpan<T> {value, static_cast<std::ptrdiff_t>(size)};
+	}
+}
@@ -1,6 +1,10 @@
 #pragma once
 
+#include <array>
+#include <stdexcept>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 
 namespace GLib::Util
 {
@@ -55,4 +59,64 @@ namespace GLib::Util
 
 		using TupleType = typename TypeFilter<AllTypesPredicate, Types...>::TupleType;
 	};
-}
\ No newline at end of file
+
+	template <typename T>
+	struct TypeTag
+	{
+		using Type = T;
+	};
+
+	// runtime index to type for a TypeList or a filtered Tuple, e.g. TypeDispatch<TypeFilter<...>::TupleType>
+	// Visit calls f(TypeTag<T>{}) through a table of function pointers built at compile time rather than a chain of tests
+	template <typename Types>
+	struct TypeDispatch;
+
+	template <typename... Types>
+	struct TypeDispatch<TypeList<Types...>>
+	{
+		static constexpr size_t Size = sizeof...(Types);
+
+		// Size if T is not in the list
+		template <typename T>
+		static constexpr size_t IndexOf()
+		{
+			constexpr std::array<bool, Size> matches {std::is_same_v<T, Types>...};
+			for (size_t i = 0; i < Size; ++i)
+			{
+				if (matches[i])
+				{
+					return i;
+				}
+			}
+			return Size;
+		}
+
+		// f must return the same type for each type in the list
+		template <typename Function>
+		static decltype(auto) Visit(size_t index, Function && f)
+		{
+			static_assert(Size != 0, "No types");
+			using First = std::tuple_element_t<0, std::tuple<TypeTag<Types>...>>;
+			using Result = decltype(std::forward<Function>(f)(First {}));
+			using Thunk = Result (*)(Function &&);
+
+			static constexpr std::array<Thunk, Size> table {&Invoke<Result, Function, Types>...};
+			if (index >= Size)
+			{
+				throw std::logic_error("Type index out of range");
+			}
+			return table[index](std::forward<Function>(f)); // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index) checked
+		}
+
+	private:
+		template <typename Result, typename Function, typename T>
+		static Result Invoke(Function && f)
+		{
+			return std::forward<Function>(f)(TypeTag<T> {});
+		}
+	};
+
+	template <typename... Types>
+	struct TypeDispatch<Tuple<Types...>> : TypeDispatch<TypeList<Types...>>
+	{};
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <GLib/ByteSet.h>
+
+#include <array>
+#include <string_view>
+
+namespace GLib::Util
+{
+	namespace Detail
+	{
+		constexpr int IncompleteSequence = -1;
+
+		inline const ByteSet & AsciiBytes()
+		{
+			static const ByteSet set {{0x00, 0x7F}};
+			return set;
+		}
+
+		// length of the well formed sequence at p (unicode table 3-7), 0 if invalid or IncompleteSequence if the available bytes are a valid prefix
+		inline int Utf8SequenceLength(const unsigned char * p, size_t available)
+		{
+			constexpr unsigned char ContinuationFirst = 0x80;
+			constexpr unsigned char ContinuationLast = 0xBF;
+			constexpr unsigned char TwoByteLead = 0xC2;
+			constexpr unsigned char ThreeByteLead = 0xE0;
+			constexpr unsigned char SurrogateLead = 0xED;
+			constexpr unsigned char FourByteLead = 0xF0;
+			constexpr unsigned char MaxLead = 0xF4;
+
+			const unsigned char lead = p[0];
+			if (lead < ContinuationFirst)
+			{
+				return 1;
+			}
+			if (lead < TwoByteLead || lead > MaxLead)
+			{
+				return 0;
+			}
+
+			// the second byte range excludes overlong forms, surrogates and code points past U+10FFFF
+			int length = 2;
+			unsigned char first = ContinuationFirst;
+			unsigned char last = ContinuationLast;
+			if (lead >= FourByteLead)
+			{
+				length = 4;
+				first = lead == FourByteLead ? 0x90 : first; // NOLINT(readability-magic-numbers) U+10000
+				last = lead == MaxLead ? 0x8F : last;				 // NOLINT(readability-magic-numbers) U+10FFFF
+			}
+			else if (lead >= ThreeByteLead)
+			{
+				length = 3;
+				first = lead == ThreeByteLead ? 0xA0 : first; // NOLINT(readability-magic-numbers) U+0800
+				last = lead == SurrogateLead ? 0x9F : last;		// NOLINT(readability-magic-numbers) U+D7FF
+			}
+
+			for (int k = 1; k < length; ++k)
+			{
+				if (static_cast<size_t>(k) >= available)
+				{
+					return IncompleteSequence;
+				}
+				const unsigned char c = p[k]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) checked against available
+				if (c < first || c > last)
+				{
+					return 0;
+				}
+				first = ContinuationFirst;
+				last = ContinuationLast;
+			}
+			return length;
+		}
+	}
+
+	// validates utf8 fed in chunks of any size, sequences may be split between chunks
+	// ascii is skipped with the vectorised ByteSet scan, only other bytes are checked one sequence at a time
+	class Utf8Validator
+	{
+		static constexpr size_t MaxSequenceLength = 4;
+
+		std::array<unsigned char, MaxSequenceLength> carry {};
+		size_t carryCount {};
+		size_t offset {};
+
+	public:
+		// returns the stream offset of the first invalid sequence or npos, the validator should not be used after an error
+		size_t Feed(std::string_view chunk)
+		{
+			size_t i {};
+			if (carryCount != 0)
+			{
+				const size_t sequenceOffset = offset - carryCount;
+				int length = Detail::IncompleteSequence;
+				while (length == Detail::IncompleteSequence && i < chunk.size())
+				{
+					carry[carryCount++] = static_cast<unsigned char>(chunk[i++]);
+					length = Detail::Utf8SequenceLength(carry.data(), carryCount);
+				}
+
+				if (length == 0)
+				{
+					return sequenceOffset;
+				}
+				if (length == Detail::IncompleteSequence)
+				{
+					offset += chunk.size();
+					return std::string_view::npos;
+				}
+				carryCount = 0;
+			}
+
+			const auto * data = reinterpret_cast<const unsigned char *>(chunk.data()); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast) byte view
+			while ((i = FindFirstNotOf(chunk, Detail::AsciiBytes(), i)) != std::string_view::npos)
+			{
+				const int length = Detail::Utf8SequenceLength(data + i, chunk.size() - i); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) i < size
+				if (length == 0)
+				{
+					return offset + i;
+				}
+				if (length == Detail::IncompleteSequence)
+				{
+					for (; i < chunk.size(); ++i)
+					{
+						carry[carryCount++] = data[i]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) i < size
+					}
+					break;
+				}
+				i += static_cast<size_t>(length);
+			}
+			offset += chunk.size();
+			return std::string_view::npos;
+		}
+
+		// returns the stream offset of a sequence truncated by the end of input or npos
+		size_t Finish() const
+		{
+			return carryCount != 0 ? offset - carryCount : std::string_view::npos;
+		}
+
+		// bytes of an incomplete sequence at the end of the last chunk
+		size_t Pending() const
+		{
+			return carryCount;
+		}
+	};
+
+	inline bool IsValidUtf8(std::string_view value)
+	{
+		Utf8Validator validator;
+		return validator.Feed(value) == std::string_view::npos && validator.Finish() == std::string_view::npos;
+	}
+}
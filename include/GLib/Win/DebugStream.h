@@ -4,31 +4,63 @@
 
 #include <GLib/cvt.h>
 #include <GLib/genericoutstream.h>
-#include <GLib/vectorstreambuffer.h>
+
+#include <streambuf>
+#include <string>
+#include <string_view>
 
 namespace GLib::Win::Debug
 {
 	namespace Detail
 	{
 		static constexpr auto DefaultCapacity = 256;
-		using Buffer = GLib::Util::VectorStreamBuffer<char, DefaultCapacity>;
 
-		class DebugBuffer : public Buffer
+		// unbuffered so every character reaches overflow and each line is written as it is completed
+		class DebugBuffer : public std::streambuf
 		{
+			std::string line;
+
+		public:
+			DebugBuffer()
+			{
+				line.reserve(DefaultCapacity);
+			}
+
+		protected:
 			int_type overflow(int_type c) override
 			{
-				c = Buffer::overflow(c);
-				if (c == traits_type::to_char_type('\n'))
+				if (traits_type::eq_int_type(c, traits_type::eof()))
+				{
+					return traits_type::not_eof(c);
+				}
+				line.push_back(traits_type::to_char_type(c));
+				if (c == traits_type::to_int_type('\n'))
 				{
-					Write(Get());
+					Write();
 				}
 				return c;
 			}
 
-			void Write(std::string_view s)
+			std::streamsize xsputn(const char * s, std::streamsize count) override
+			{
+				std::string_view value {s, static_cast<size_t>(count)};
+				for (size_t newLine {}; (newLine = value.find('\n')) != std::string_view::npos;)
+				{
+					line.append(value.substr(0, newLine + 1));
+					Write();
+					value.remove_prefix(newLine + 1);
+				}
+				line.append(value);
+				return count;
+			}
+
+		private:
+			void Write()
 			{
-				::OutputDebugStringW(Cvt::a2w(s).c_str());
-				Reset();
+				Util::WideCharBuffer wide;
+				(void) Cvt::a2w(line, wide);
+				::OutputDebugStringW(wide.Get());
+				line.clear();
 			}
 		};
 	}
@@ -289,10 +289,10 @@ namespace GLib::Win
 			}
 
 			message.erase(std::remove(message.begin(), message.end(), '\r'), message.end());
-			GLib::Util::Splitter splitter(message, "\n");
+			GLib::Util::Splitter splitter(GLib::Util::NonOwning, message, "\n");
 			for (auto it = splitter.begin(), end = splitter.end(); it != end;)
 			{
-				std::string s = *it;
+				std::string_view s = *it;
 				if (++it != end)
 				{
 					Debug::Stream() << "GDB: " << pendingDebugOut << s << std::endl;
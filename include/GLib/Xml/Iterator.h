@@ -5,7 +5,9 @@
 #include <GLib/Xml/StateEngine.h>
 
 #include <iterator>
+#include <memory_resource>
 #include <sstream>
+#include <vector>
 
 /*
 Design:
@@ -45,7 +47,7 @@ namespace GLib::Xml
 		///////////
 
 		Element element;
-		std::stack<std::string_view> elementStack;
+		std::stack<std::string_view, std::pmr::vector<std::string_view>> elementStack;
 
 	public:
 		using iterator_category = std::forward_iterator_tag;
@@ -54,11 +56,13 @@ namespace GLib::Xml
 		using pointer = void;
 		using reference = void;
 
-		Iterator(const char * begin, const char * end, NameSpaceManager * manager)
+		Iterator(const char * begin, const char * end, NameSpaceManager * manager,
+						 std::pmr::memory_resource * resource = std::pmr::get_default_resource())
 			: ptr(begin)
 			, end(end)
 			, lastPtr(begin)
 			, manager(manager)
+			, elementStack(std::pmr::vector<std::string_view>(resource))
 		{
 			Advance();
 		}
@@ -322,16 +326,20 @@ namespace GLib::Xml
 	class Holder
 	{
 		std::string_view const value;
+		std::pmr::memory_resource * const resource;
 		NameSpaceManager manager;
 
 	public:
-		Holder(std::string_view value)
+		// the parser's working containers are allocated from resource e.g. Util::ThreadArenaResource()
+		Holder(std::string_view value, std::pmr::memory_resource * resource = std::pmr::get_default_resource())
 			: value(value)
+			, resource(resource)
+			, manager(resource)
 		{}
 
 		Iterator begin()
 		{
-			return {value.data(), value.size() + value.data(), &manager};
+			return {value.data(), value.size() + value.data(), &manager, resource};
 		}
 
 		Iterator end() const
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <deque>
+#include <memory_resource>
 #include <stack>
 #include <stdexcept>
 #include <string_view>
@@ -11,10 +13,18 @@ namespace GLib::Xml
 	{
 		static constexpr std::string_view Attribute = "xmlns:";
 
-		std::unordered_map<std::string_view, std::string_view> nameSpaces;
-		std::stack<std::pair<size_t, std::pair<std::string_view, std::string_view>>> nameSpaceStack;
+		using Declaration = std::pair<size_t, std::pair<std::string_view, std::string_view>>;
+
+		std::pmr::unordered_map<std::string_view, std::string_view> nameSpaces;
+		std::stack<Declaration, std::pmr::deque<Declaration>> nameSpaceStack;
 
 	public:
+		// resource e.g. Util::ThreadArenaResource() for a parse released with one reset
+		explicit NameSpaceManager(std::pmr::memory_resource * resource = std::pmr::get_default_resource())
+			: nameSpaces(resource)
+			, nameSpaceStack(std::pmr::deque<Declaration>(resource))
+		{}
+
 		static bool IsDeclaration(const std::string_view & value)
 		{
 			return value.compare(0, Attribute.size(), Attribute) == 0;
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <GLib/PerfectHash.h>
+
 #include <array>
 #include <ostream>
 #include <string_view>
@@ -19,7 +21,7 @@ namespace GLib::Xml::Utils
 		return {start, static_cast<size_t>(end - start)};
 	}
 
-	using Entity = std::pair<const char *, char>;
+	using Entity = std::pair<std::string_view, char>;
 
 	// clang-format off
 	static constexpr auto EntitySize = 5;
@@ -33,6 +35,8 @@ namespace GLib::Xml::Utils
 	};
 	// clang-format on
 
+	static constexpr Util::PerfectHashMap<char, EntitySize> entityValues {entities};
+
 	inline std::ostream & Escape(std::string_view value, std::ostream & out)
 	{
 		for (size_t startPos = 0;;)
@@ -58,4 +62,40 @@ namespace GLib::Xml::Utils
 		}
 		return out;
 	}
-}
\ No newline at end of file
+
+	// replaces the standard entities, others such as character references are written unchanged
+	inline std::ostream & Unescape(std::string_view value, std::ostream & out)
+	{
+		for (size_t startPos = 0;;)
+		{
+			const size_t ampersand = value.find('&', startPos);
+			const size_t semicolon = ampersand == std::string_view::npos ? ampersand : value.find(';', ampersand);
+			if (semicolon == std::string_view::npos)
+			{
+				out << value.substr(startPos);
+				break;
+			}
+
+			const size_t nextAmpersand = value.find('&', ampersand + 1);
+			if (nextAmpersand < semicolon)
+			{
+				out << value.substr(startPos, nextAmpersand - startPos);
+				startPos = nextAmpersand;
+				continue;
+			}
+
+			out << value.substr(startPos, ampersand - startPos);
+			const std::string_view entity = value.substr(ampersand, semicolon + 1 - ampersand);
+			if (const char * unescaped = entityValues.find(entity))
+			{
+				out << *unescaped;
+			}
+			else
+			{
+				out << entity;
+			}
+			startPos = semicolon + 1;
+		}
+		return out;
+	}
+}
@@ -1,61 +1,264 @@
 #pragma once
 
+#include <GLib/Span.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
 #include <limits>
+#include <optional>
 #include <stdexcept>
+#include <string>
 #include <type_traits>
+#include <vector>
 
 namespace GLib::Util
 {
-	namespace Detail
+	// what checked_cast does with a value outside the target's range
+	// each policy maps Underflow, Overflow and NotANumber (floating point to integral) to a Result, and wraps valid values with Valid
+	namespace CastPolicy
 	{
-		struct OverflowPolicy
+		struct Throw
 		{
-			// use std::overflow\underflow?
-			static void Underflow(bool err)
+			template <typename Target>
+			using Result = Target;
+
+			template <typename Target, typename Source>
+			[[noreturn]] static Target Underflow(Source source)
 			{
-				if (err)
-				{
-					throw std::runtime_error("Underflow");
-				}
+				(void) source;
+				throw std::runtime_error("Underflow");
 			}
 
-			static void Overflow(bool err)
+			template <typename Target, typename Source>
+			[[noreturn]] static Target Overflow(Source source)
 			{
-				if (err)
-				{
-					throw std::runtime_error("Overflow");
-				}
+				(void) source;
+				throw std::runtime_error("Overflow");
+			}
+
+			template <typename Target>
+			[[noreturn]] static Target NotANumber()
+			{
+				throw std::runtime_error("Not a number");
+			}
+
+			template <typename Target>
+			static Target Valid(Target value)
+			{
+				return value;
+			}
+		};
+
+		// clamps to the target's range, not a number converts to zero
+		struct Saturate
+		{
+			template <typename Target>
+			using Result = Target;
+
+			template <typename Target, typename Source>
+			static Target Underflow(Source source)
+			{
+				(void) source;
+				return std::numeric_limits<Target>::lowest();
+			}
+
+			template <typename Target, typename Source>
+			static Target Overflow(Source source)
+			{
+				(void) source;
+				return std::numeric_limits<Target>::max();
+			}
+
+			template <typename Target>
+			static Target NotANumber()
+			{
+				return Target {};
+			}
+
+			template <typename Target>
+			static Target Valid(Target value)
+			{
+				return value;
+			}
+		};
+
+		// modulo 2^N as static_cast, integral types only
+		struct Wrap
+		{
+			template <typename Target>
+			using Result = Target;
+
+			template <typename Target, typename Source>
+			static Target Underflow(Source source)
+			{
+				static_assert(std::is_integral_v<Target> && std::is_integral_v<Source>, "Wrap requires integral types");
+				return static_cast<Target>(source);
+			}
+
+			template <typename Target, typename Source>
+			static Target Overflow(Source source)
+			{
+				static_assert(std::is_integral_v<Target> && std::is_integral_v<Source>, "Wrap requires integral types");
+				return static_cast<Target>(source);
+			}
+
+			template <typename Target>
+			static Target Valid(Target value)
+			{
+				return value;
+			}
+		};
+
+		struct Optional
+		{
+			template <typename Target>
+			using Result = std::optional<Target>;
+
+			template <typename Target, typename Source>
+			static Result<Target> Underflow(Source source)
+			{
+				(void) source;
+				return {};
+			}
+
+			template <typename Target, typename Source>
+			static Result<Target> Overflow(Source source)
+			{
+				(void) source;
+				return {};
+			}
+
+			template <typename Target>
+			static Result<Target> NotANumber()
+			{
+				return {};
+			}
+
+			template <typename Target>
+			static Result<Target> Valid(Target value)
+			{
+				return value;
 			}
 		};
 
-		template <typename T, typename S, typename OverflowPolicy>
-		struct OverflowHandler
+		// checked by assert in debug builds, a plain static_cast otherwise
+		struct Assert
+		{
+			template <typename Target>
+			using Result = Target;
+
+			template <typename Target, typename Source>
+			static Target Underflow(Source source)
+			{
+				assert(!"Underflow"); // NOLINT(cppcoreguidelines-pro-bounds-array-to-pointer-decay,hicpp-no-array-decay) assert macro
+				return static_cast<Target>(source);
+			}
+
+			template <typename Target, typename Source>
+			static Target Overflow(Source source)
+			{
+				assert(!"Overflow"); // NOLINT(cppcoreguidelines-pro-bounds-array-to-pointer-decay,hicpp-no-array-decay) assert macro
+				return static_cast<Target>(source);
+			}
+
+			template <typename Target>
+			static Target NotANumber()
+			{
+				assert(!"Not a number"); // NOLINT(cppcoreguidelines-pro-bounds-array-to-pointer-decay,hicpp-no-array-decay) assert macro
+				return Target {};
+			}
+
+			template <typename Target>
+			static Target Valid(Target value)
+			{
+				return value;
+			}
+		};
+	}
+
+	namespace Detail
+	{
+		// range tests of a source value against the target type, floating point sources are truncated toward zero by the conversion
+		template <typename T, typename S>
+		struct RangeLimits
 		{
 			using Target = T;
 			using Source = S;
 
-			static void UnderflowMin(Source source)
+			static constexpr bool FloatToIntegral = std::is_floating_point_v<Source> && std::is_integral_v<Target>;
+
+			static bool IsNaN(Source source)
 			{
-				OverflowPolicy::Underflow(source < static_cast<Source>(std::numeric_limits<Target>::lowest()));
+				if constexpr (FloatToIntegral)
+				{
+					return source != source; // NOLINT(misc-redundant-expression) only true for NaN
+				}
+				else
+				{
+					(void) source;
+					return false;
+				}
 			}
 
-			static void UnderflowZero(Source source)
+			static bool BelowMin(Source source)
 			{
-				OverflowPolicy::Underflow(source < static_cast<Source>(0));
+				constexpr auto lowest = static_cast<Source>(std::numeric_limits<Target>::lowest());
+				if constexpr (FloatToIntegral)
+				{
+					// values in (lowest - 1, lowest) truncate to lowest, if lowest - 1 is not representable there are no such values
+					constexpr Source belowLowest = lowest - 1;
+					return belowLowest < lowest ? source <= belowLowest : source < lowest;
+				}
+				else if constexpr (std::is_floating_point_v<Source>)
+				{
+					return source < lowest && source != -std::numeric_limits<Source>::infinity();
+				}
+				else
+				{
+					return source < lowest;
+				}
 			}
 
-			static void OverflowMax(Source source)
+			static bool BelowZero(Source source)
 			{
-				OverflowPolicy::Overflow(source > static_cast<Source>(std::numeric_limits<Target>::max()));
+				if constexpr (FloatToIntegral)
+				{
+					return source <= static_cast<Source>(-1);
+				}
+				else
+				{
+					return source < static_cast<Source>(0);
+				}
+			}
+
+			static bool AboveMax(Source source)
+			{
+				if constexpr (FloatToIntegral)
+				{
+					// max is 2^digits - 1 which may round up to 2^digits, the exclusive bound 2^digits is exact
+					constexpr Source aboveMax = static_cast<Source>(std::numeric_limits<Target>::max() / 2 + 1) * 2;
+					return source >= aboveMax;
+				}
+				else if constexpr (std::is_floating_point_v<Source>)
+				{
+					return source > static_cast<Source>(std::numeric_limits<Target>::max()) && source != std::numeric_limits<Source>::infinity();
+				}
+				else
+				{
+					return source > static_cast<Source>(std::numeric_limits<Target>::max());
+				}
 			}
 		};
 
-		template <typename T, typename S>
+		template <typename T, typename S, typename P = CastPolicy::Throw>
 		struct Traits
 		{
 			using Target = T;
 			using Source = S;
-			using Overflow = OverflowHandler<T, S, OverflowPolicy>;
+			using Policy = P;
+			using Result = typename Policy::template Result<Target>;
+			using Limits = RangeLimits<T, S>;
 
 			static Target Convert(Source source)
 			{
@@ -66,11 +269,17 @@ namespace GLib::Util
 		template <typename Target, typename Source>
 		struct Flags
 		{
-			static_assert(std::is_integral<Target>::value && std::is_integral<Source>::value, "TODO: !is_integral");
+			static_assert(std::is_arithmetic<Target>::value && std::is_arithmetic<Source>::value, "checked_cast requires arithmetic types");
 			static constexpr bool SameSign = std::is_signed<Target>::value == std::is_signed<Source>::value;
 			static constexpr bool SignedToUnsigned = std::is_signed<Source>::value && std::is_unsigned<Target>::value;
 			static constexpr bool UnsignedToSigned = std::is_unsigned<Source>::value && std::is_signed<Target>::value;
-			static constexpr bool TargetSmaller = std::numeric_limits<Target>::digits < std::numeric_limits<Source>::digits;
+
+			// any integral value is in the range of a floating point type, though it may be rounded
+			static constexpr bool FloatingTarget = std::is_floating_point<Target>::value;
+			static constexpr bool FloatingSource = std::is_floating_point<Source>::value;
+			static constexpr bool TargetSmaller = FloatingTarget
+				? FloatingSource && std::numeric_limits<Target>::max_exponent < std::numeric_limits<Source>::max_exponent
+				: FloatingSource || std::numeric_limits<Target>::digits < std::numeric_limits<Source>::digits;
 
 			static constexpr bool TrivialCopy = !SignedToUnsigned && !TargetSmaller;
 			static constexpr bool CheckMinMax = SameSign && TargetSmaller;
@@ -86,59 +295,238 @@ namespace GLib::Util
 		template <typename T, typename S, typename Traits>
 		struct RangeChecker<T, S, Traits, typename std::enable_if<Flags<T, S>::TrivialCopy>::type>
 		{
-			static T Check(S source)
+			static typename Traits::Result Check(S source)
 			{
-				return source;
+				return Traits::Policy::Valid(Traits::Convert(source));
 			}
 		};
 
 		template <typename T, typename S, typename Traits>
 		struct RangeChecker<T, S, Traits, typename std::enable_if<Flags<T, S>::CheckMinMax>::type>
 		{
-			static T Check(S source)
+			static typename Traits::Result Check(S source)
 			{
-				Traits::Overflow::UnderflowMin(source);
-				Traits::Overflow::OverflowMax(source);
-				return Traits::Convert(source);
+				using Limits = typename Traits::Limits;
+				using Policy = typename Traits::Policy;
+				if constexpr (Limits::FloatToIntegral)
+				{
+					if (Limits::IsNaN(source))
+					{
+						return Policy::template NotANumber<T>();
+					}
+				}
+				if (Limits::BelowMin(source))
+				{
+					return Policy::template Underflow<T>(source);
+				}
+				if (Limits::AboveMax(source))
+				{
+					return Policy::template Overflow<T>(source);
+				}
+				return Policy::Valid(Traits::Convert(source));
 			}
 		};
 
 		template <typename T, typename S, typename Traits>
 		struct RangeChecker<T, S, Traits, typename std::enable_if<Flags<T, S>::CheckZeroMax>::type>
 		{
-			static T Check(S source)
+			static typename Traits::Result Check(S source)
 			{
-				Traits::Overflow::UnderflowZero(source);
-				Traits::Overflow::OverflowMax(source);
-				return Traits::Convert(source);
+				using Limits = typename Traits::Limits;
+				using Policy = typename Traits::Policy;
+				if constexpr (Limits::FloatToIntegral)
+				{
+					if (Limits::IsNaN(source))
+					{
+						return Policy::template NotANumber<T>();
+					}
+				}
+				if (Limits::BelowZero(source))
+				{
+					return Policy::template Underflow<T>(source);
+				}
+				if (Limits::AboveMax(source))
+				{
+					return Policy::template Overflow<T>(source);
+				}
+				return Policy::Valid(Traits::Convert(source));
 			}
 		};
 
 		template <typename T, typename S, typename Traits>
 		struct RangeChecker<T, S, Traits, typename std::enable_if<Flags<T, S>::CheckZero>::type>
 		{
-			static T Check(S source)
+			static typename Traits::Result Check(S source)
 			{
-				Traits::Overflow::UnderflowZero(source);
-				return Traits::Convert(source);
+				if (Traits::Limits::BelowZero(source))
+				{
+					return Traits::Policy::template Underflow<T>(source);
+				}
+				return Traits::Policy::Valid(Traits::Convert(source));
 			}
 		};
 
 		template <typename T, typename S, typename Traits>
 		struct RangeChecker<T, S, Traits, typename std::enable_if<Flags<T, S>::CheckMax>::type>
 		{
-			static T Check(S source)
+			static typename Traits::Result Check(S source)
 			{
-				Traits::Overflow::OverflowMax(source);
-				return Traits::Convert(source);
+				if (Traits::Limits::AboveMax(source))
+				{
+					return Traits::Policy::template Overflow<T>(source);
+				}
+				return Traits::Policy::Valid(Traits::Convert(source));
 			}
 		};
 	}
 
-	template <typename Target, typename Source>
-	Target checked_cast(Source source)
+	// e.g. checked_cast<short>(i) throws, checked_cast<short, CastPolicy::Saturate>(i) clamps
+	template <typename Target, typename Policy = CastPolicy::Throw, typename Source>
+	typename Policy::template Result<Target> checked_cast(Source source)
 	{
-		using Traits = Detail::Traits<Target, Source>;
+		using Traits = Detail::Traits<Target, Source, Policy>;
 		return Detail::RangeChecker<typename Traits::Target, typename Traits::Source, Traits>::Check(source);
 	}
-}
\ No newline at end of file
+
+	// the error from checked_cast for the first value of a range that does not convert
+	class RangeCastError : public std::runtime_error
+	{
+		size_t index;
+
+	public:
+		RangeCastError(const std::runtime_error & error, size_t index)
+			: std::runtime_error(std::string(error.what()) + " at index " + std::to_string(index))
+			, index(index)
+		{}
+
+		size_t Index() const noexcept
+		{
+			return index;
+		}
+	};
+
+	namespace Detail
+	{
+		// fixed trip count so that the compiler vectorises the loop without needing a scalar epilogue
+		constexpr size_t CastLanes = 16;
+
+		template <typename T>
+		constexpr auto SignBit(T value)
+		{
+			using Unsigned = std::make_unsigned_t<T>;
+			if constexpr (std::is_signed_v<T>)
+			{
+				return static_cast<Unsigned>(static_cast<Unsigned>(value) >> std::numeric_limits<T>::digits);
+			}
+			else
+			{
+				(void) value;
+				return Unsigned {};
+			}
+		}
+
+		// converts CastLanes values into block returning false if any would be rejected by RangeChecker
+		// a value is accepted if it survives the round trip with its sign, tested without comparisons which SSE2 lacks for 64 bit values
+		template <typename Target, typename Source>
+		bool ConvertLanes(const Source * source, std::array<Target, CastLanes> & block)
+		{
+			using SourceBits = std::make_unsigned_t<Source>;
+			using Bits = std::conditional_t<(sizeof(Source) > sizeof(Target)), SourceBits, std::make_unsigned_t<Target>>;
+
+			Bits bad {};
+			for (size_t lane = 0; lane < CastLanes; ++lane)
+			{
+				const Source value = source[lane]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) lane < CastLanes
+				const auto converted = static_cast<Target>(value);
+				const auto roundTrip = static_cast<SourceBits>(static_cast<SourceBits>(static_cast<Source>(converted)) ^ static_cast<SourceBits>(value));
+				bad |= static_cast<Bits>(roundTrip) | static_cast<Bits>(static_cast<Bits>(SignBit(value)) ^ static_cast<Bits>(SignBit(converted)));
+				block[lane] = converted;
+			}
+			return bad == 0;
+		}
+
+		template <typename Checker, typename Source>
+		[[noreturn]] void ThrowFirstError(const Source * source, size_t start, size_t count)
+		{
+			for (size_t i = start; i < count; ++i)
+			{
+				try
+				{
+					(void) Checker::Check(source[i]); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) i < count
+				}
+				catch (const std::runtime_error & e)
+				{
+					throw RangeCastError(e, i);
+				}
+			}
+			throw std::logic_error("No conversion error found");
+		}
+
+		// target holds at least count values
+		template <typename Target, typename Source>
+		void CheckedCastRange(const Source * values, size_t count, Target * target)
+		{
+			using Traits = Traits<Target, Source>;
+			using Checker = RangeChecker<typename Traits::Target, typename Traits::Source, Traits>;
+
+			if constexpr (Flags<Target, Source>::TrivialCopy)
+			{
+				std::transform(values, values + count, target, Traits::Convert); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) count values
+			}
+			else
+			{
+				std::array<Target, CastLanes> block {};
+				size_t i {};
+				if constexpr (std::is_integral_v<Target> && std::is_integral_v<Source>)
+				{
+					for (; count - i >= CastLanes; i += CastLanes)
+					{
+						if (!ConvertLanes(values + i, block)) // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) i < count
+						{
+							ThrowFirstError<Checker>(values, i, count);
+						}
+						std::copy(block.begin(), block.end(), target + i); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) i < count
+					}
+				}
+				for (; i < count; i += CastLanes)
+				{
+					const size_t blockSize = std::min(CastLanes, count - i);
+					for (size_t lane = 0; lane < blockSize; ++lane)
+					{
+						try
+						{
+							block[lane] = Checker::Check(values[i + lane]); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) i + lane < count
+						}
+						catch (const std::runtime_error & e)
+						{
+							throw RangeCastError(e, i + lane);
+						}
+					}
+					std::copy_n(block.begin(), blockSize, target + i); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) i < count
+				}
+			}
+		}
+	}
+
+	// checked_cast of each value, integral values are converted in vectorised blocks with one check per block
+	// throws RangeCastError with the index of the first value that checked_cast would reject
+	// each block of CastLanes values is checked before it is stored, so on error the blocks before the failing one have been written
+	// and the rest of target is unchanged
+	template <typename Target, typename Source>
+	void checked_cast_range(Span<Source> source, MutableSpan<Target> target)
+	{
+		if (target.size() < source.size())
+		{
+			throw std::logic_error("Target is smaller than source");
+		}
+		Detail::CheckedCastRange(source.data(), static_cast<size_t>(source.size()), target.data());
+	}
+
+	template <typename Target, typename Source>
+	std::vector<Target> checked_cast_range(Span<Source> source)
+	{
+		std::vector<Target> target(static_cast<size_t>(source.size()));
+		Detail::CheckedCastRange(source.data(), static_cast<size_t>(source.size()), target.data());
+		return target;
+	}
+}
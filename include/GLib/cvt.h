@@ -1,37 +1,315 @@
 #pragma once
 
-#include <codecvt>
-#include <locale>
+#include <GLib/ByteSet.h>
+#include <GLib/stackorheap.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 
 namespace GLib::Cvt
 {
-#ifdef _MSC_VER
-#pragma warning(push)
-#pragma warning(disable : 4996) // until have proper\efficient fix
-#endif
+	// wchar_t is utf16 on windows and utf32 elsewhere, invalid input (overlong, surrogate or out of range code points) throws
 	namespace Detail
 	{
-#ifdef __linux__
-		using Converter = std::wstring_convert<std::codecvt_utf8<wchar_t>, wchar_t>;
-#elif _WIN32
-		using Converter = std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>, wchar_t>;
-#endif
+		constexpr char32_t AsciiLimit = 0x80;
+		constexpr char32_t TwoByteLimit = 0x800;
+		constexpr char32_t ThreeByteLimit = 0x10000;
+		constexpr char32_t MaxCodePoint = 0x10FFFF;
+		constexpr char32_t HighSurrogate = 0xD800;
+		constexpr char32_t LowSurrogate = 0xDC00;
+		constexpr char32_t SurrogateEnd = 0xE000;
+		constexpr unsigned int SurrogateBits = 10;
+		constexpr char32_t SurrogateMask = 0x3FF;
+
+		constexpr unsigned int ContinuationBits = 6;
+		constexpr unsigned char ContinuationMask = 0x3F;
+		constexpr unsigned char ContinuationTag = 0x80;
+		constexpr unsigned char ContinuationTagMask = 0xC0;
+		constexpr unsigned char FourByteLead = 0xF0;
+
+		constexpr size_t MaxUtf8PerWide = sizeof(wchar_t) == 2 ? 3 : 4;
+
+		inline const Util::ByteSet & Ascii()
+		{
+			static const Util::ByteSet set {{0x00, 0x7F}};
+			return set;
+		}
+
+		inline bool IsSurrogate(char32_t c)
+		{
+			return c >= HighSurrogate && c < SurrogateEnd;
+		}
+
+		inline char32_t DecodeUtf8(std::string_view s, size_t & i)
+		{
+			const auto lead = static_cast<unsigned char>(s[i]);
+			size_t length {};
+			char32_t c {};
+			char32_t min {};
+			if ((lead & 0xE0U) == 0xC0U) // NOLINT(readability-magic-numbers) 110xxxxx
+			{
+				length = 2;
+				c = lead & 0x1FU; // NOLINT(readability-magic-numbers) 110xxxxx
+				min = AsciiLimit;
+			}
+			else if ((lead & 0xF0U) == 0xE0U) // NOLINT(readability-magic-numbers) 1110xxxx
+			{
+				length = 3;
+				c = lead & 0x0FU; // NOLINT(readability-magic-numbers) 1110xxxx
+				min = TwoByteLimit;
+			}
+			else if ((lead & 0xF8U) == 0xF0U) // NOLINT(readability-magic-numbers) 11110xxx
+			{
+				length = 4;
+				c = lead & 0x07U; // NOLINT(readability-magic-numbers) 11110xxx
+				min = ThreeByteLimit;
+			}
+			else
+			{
+				throw std::runtime_error("Invalid UTF-8");
+			}
+
+			if (s.size() - i < length)
+			{
+				throw std::runtime_error("Invalid UTF-8");
+			}
+
+			for (size_t k = 1; k < length; ++k)
+			{
+				const auto next = static_cast<unsigned char>(s[i + k]);
+				if ((next & ContinuationTagMask) != ContinuationTag)
+				{
+					throw std::runtime_error("Invalid UTF-8");
+				}
+				c = c << ContinuationBits | (next & ContinuationMask);
+			}
+
+			if (c < min || c > MaxCodePoint || IsSurrogate(c))
+			{
+				throw std::runtime_error("Invalid UTF-8");
+			}
+			i += length;
+			return c;
+		}
+
+		inline wchar_t * EncodeWide(char32_t c, wchar_t * dest)
+		{
+			if constexpr (sizeof(wchar_t) == 2)
+			{
+				if (c >= ThreeByteLimit)
+				{
+					c -= ThreeByteLimit;
+					*dest++ = static_cast<wchar_t>(HighSurrogate + (c >> SurrogateBits)); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) sized by caller
+					*dest++ = static_cast<wchar_t>(LowSurrogate + (c & SurrogateMask));		// NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) sized by caller
+					return dest;
+				}
+			}
+			*dest++ = static_cast<wchar_t>(c); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) sized by caller
+			return dest;
+		}
+
+		inline char32_t DecodeWide(std::wstring_view s, size_t & i)
+		{
+			auto c = static_cast<char32_t>(s[i++]);
+			if constexpr (sizeof(wchar_t) == 2)
+			{
+				if (c >= HighSurrogate && c < LowSurrogate && i < s.size())
+				{
+					const auto low = static_cast<char32_t>(s[i]);
+					if (low >= LowSurrogate && low < SurrogateEnd)
+					{
+						++i;
+						return ThreeByteLimit + ((c - HighSurrogate) << SurrogateBits) + (low - LowSurrogate);
+					}
+				}
+			}
+
+			if (c > MaxCodePoint || IsSurrogate(c))
+			{
+				throw std::runtime_error("Invalid wide string");
+			}
+			return c;
+		}
+
+		inline char * EncodeUtf8(char32_t c, char * dest)
+		{
+			auto put = [&](unsigned int value) { *dest++ = static_cast<char>(value); }; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) sized by caller
+			auto continuation = [](char32_t value, unsigned int shift) { return ContinuationTag | ((value >> shift) & ContinuationMask); };
+
+			if (c < TwoByteLimit)
+			{
+				put(0xC0U | (c >> ContinuationBits)); // NOLINT(readability-magic-numbers) 110xxxxx
+			}
+			else if (c < ThreeByteLimit)
+			{
+				put(0xE0U | (c >> (2 * ContinuationBits))); // NOLINT(readability-magic-numbers) 1110xxxx
+				put(continuation(c, ContinuationBits));
+			}
+			else
+			{
+				put(0xF0U | (c >> (3 * ContinuationBits))); // NOLINT(readability-magic-numbers) 11110xxx
+				put(continuation(c, 2 * ContinuationBits));
+				put(continuation(c, ContinuationBits));
+			}
+			put(continuation(c, 0));
+			return dest;
+		}
+
+		constexpr size_t LengthBlockSize = 1U << 16U;
+
+		// characters Utf8ToWide writes for valid s, one per lead byte and two for a surrogate pair on windows
+		// invalid input throws before more than this is written
+		// counted in 32 bit blocks without branches so the loop vectorises
+		inline size_t WideLength(std::string_view s)
+		{
+			size_t length {};
+			for (size_t start = 0; start < s.size(); start += LengthBlockSize)
+			{
+				const size_t end = std::min(s.size(), start + LengthBlockSize);
+				uint32_t count {};
+				for (size_t i = start; i < end; ++i)
+				{
+					const auto byte = static_cast<unsigned char>(s[i]);
+					count += static_cast<uint32_t>((byte & ContinuationTagMask) != ContinuationTag);
+					if constexpr (sizeof(wchar_t) == 2)
+					{
+						count += static_cast<uint32_t>(byte >= FourByteLead);
+					}
+				}
+				length += count;
+			}
+			return length;
+		}
+
+		// bytes WideToUtf8 writes for valid s, invalid input throws before more than this is written
+		// counted as WideLength, each half of a surrogate pair counts 2
+		inline size_t Utf8Length(std::wstring_view s)
+		{
+			size_t length = s.size();
+			for (size_t start = 0; start < s.size(); start += LengthBlockSize)
+			{
+				const size_t end = std::min(s.size(), start + LengthBlockSize);
+				uint32_t extra {};
+				for (size_t i = start; i < end; ++i)
+				{
+					const auto c = static_cast<uint32_t>(s[i]);
+					extra += static_cast<uint32_t>(c >= AsciiLimit) + static_cast<uint32_t>(c >= TwoByteLimit) + static_cast<uint32_t>(c >= ThreeByteLimit);
+					if constexpr (sizeof(wchar_t) == 2)
+					{
+						extra -= static_cast<uint32_t>(IsSurrogate(c));
+					}
+				}
+				length += extra;
+			}
+			return length;
+		}
+
+		// dest has room for WideLength(s) characters, s.size() is always enough, returns the number written
+		inline size_t Utf8ToWide(std::string_view s, wchar_t * dest)
+		{
+			wchar_t * const start = dest;
+			for (size_t i = 0; i < s.size();)
+			{
+				// ascii runs are found by the vectorised scan and widened in a loop the compiler can vectorise
+				const size_t asciiEnd = std::min(Util::FindFirstNotOf(s, Ascii(), i), s.size());
+				for (; i < asciiEnd; ++i)
+				{
+					*dest++ = static_cast<wchar_t>(s[i]); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) sized by caller
+				}
+
+				if (i != s.size())
+				{
+					dest = EncodeWide(DecodeUtf8(s, i), dest);
+				}
+			}
+			return static_cast<size_t>(dest - start);
+		}
+
+		// dest has room for Utf8Length(s) characters, s.size() * MaxUtf8PerWide is always enough, returns the number written
+		inline size_t WideToUtf8(std::wstring_view s, char * dest)
+		{
+			char * const start = dest;
+			for (size_t i = 0; i < s.size();)
+			{
+				for (; i < s.size() && static_cast<char32_t>(s[i]) < AsciiLimit; ++i)
+				{
+					*dest++ = static_cast<char>(s[i]); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) sized by caller
+				}
+
+				if (i != s.size())
+				{
+					dest = EncodeUtf8(DecodeWide(s, i), dest);
+				}
+			}
+			return static_cast<size_t>(dest - start);
+		}
+	}
+
+	// appends to out, reusing its capacity, out is unchanged if the conversion fails
+	// out is sized exactly by a counting pass so no excess capacity is left for non-ascii text
+	inline void AppendA2W(std::wstring & out, std::string_view s)
+	{
+		const size_t start = out.size();
+		out.resize(start + Detail::WideLength(s));
+		try
+		{
+			out.resize(start + Detail::Utf8ToWide(s, out.data() + start)); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) resized above
+		}
+		catch (...)
+		{
+			out.resize(start);
+			throw;
+		}
+	}
+
+	inline void AppendW2A(std::string & out, std::wstring_view s)
+	{
+		const size_t start = out.size();
+		out.resize(start + Detail::Utf8Length(s));
+		try
+		{
+			out.resize(start + Detail::WideToUtf8(s, out.data() + start)); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) resized above
+		}
+		catch (...)
+		{
+			out.resize(start);
+			throw;
+		}
 	}
 
 	inline std::wstring a2w(std::string_view s)
 	{
-		return Detail::Converter().from_bytes(s.data(), s.data() + s.size());
-		// Detail::AssertTrue(convert.converted() == s.size(), "conversion failed");
+		std::wstring result;
+		AppendA2W(result, s);
+		return result;
 	}
 
 	inline std::string w2a(std::wstring_view s)
 	{
-		return Detail::Converter().to_bytes(s.data(), s.data() + s.size());
-		// Detail::AssertTrue(convert.converted() == s.size(), "conversion failed");
+		std::string result;
+		AppendW2A(result, s);
+		return result;
+	}
+
+	// converts into a null terminated buffer, only allocating for long values, returns the length without the terminator
+	template <size_t StackElementCount>
+	size_t a2w(std::string_view s, Util::StackOrHeap<wchar_t, StackElementCount> & buffer)
+	{
+		buffer.EnsureSize(s.size() + 1);
+		const size_t length = Detail::Utf8ToWide(s, buffer.Get());
+		buffer.Get()[length] = L'\0'; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) sized above
+		return length;
 	}
 
-#ifdef _MSC_VER
-#pragma warning(pop)
-#endif
+	template <size_t StackElementCount>
+	size_t w2a(std::wstring_view s, Util::StackOrHeap<char, StackElementCount> & buffer)
+	{
+		buffer.EnsureSize(s.size() * Detail::MaxUtf8PerWide + 1);
+		const size_t length = Detail::WideToUtf8(s, buffer.Get());
+		buffer.Get()[length] = '\0'; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) sized above
+		return length;
+	}
 }
\ No newline at end of file
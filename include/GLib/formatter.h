@@ -3,11 +3,17 @@
 
 #include <GLib/Span.h>
 #include <GLib/printfformatpolicy.h>
+#include <GLib/stackorheap.h>
 
+#include <algorithm>
 #include <array>
 #include <functional>
-#include <iomanip>
+#include <memory_resource>
 #include <sstream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <vector>
 
 // namespace Formatter?
 
@@ -43,99 +49,282 @@ namespace GLib
 			}
 		}
 
-		inline std::ostream & AppendFormatHelper(std::ostream & str, const std::string_view & view, const Span<StreamFunction> & args)
+		// code points rather than bytes, so multi byte utf8 sequences pad as one character
+		inline size_t Utf8Width(std::string_view value)
 		{
-			constexpr auto DecimalShift = 10;
-			char ch = {};
-			for (auto it = view.begin(), end = view.end();;)
+			constexpr unsigned char ContinuationMask = 0xC0U;
+			constexpr unsigned char Continuation = 0x80U;
+			return static_cast<size_t>(
+				std::count_if(value.begin(), value.end(), [](char c) { return (static_cast<unsigned char>(c) & ContinuationMask) != Continuation; }));
+		}
+
+		constexpr size_t HeldArgumentSize = 64;
+		constexpr size_t PadBlockSize = 16;
+
+		// counts the code points written, passing them on to target or holding them until the padding before them is written
+		class WidthCounter : public std::streambuf
+		{
+			std::streambuf * target;
+			Util::SmallVector<char, HeldArgumentSize> held;
+			size_t width {};
+
+		public:
+			explicit WidthCounter(std::streambuf * target)
+				: target(target)
+			{}
+
+			size_t Width() const
+			{
+				return width;
+			}
+
+			bool WriteHeld(std::streambuf & out) const
+			{
+				const auto size = static_cast<std::streamsize>(held.size());
+				return out.sputn(held.data(), size) == size;
+			}
+
+		protected:
+			int_type overflow(int_type c) override
 			{
-				while (it != end)
+				if (traits_type::eq_int_type(c, traits_type::eof()))
 				{
-					ch = *it++;
+					return traits_type::not_eof(c);
+				}
+				const char ch = traits_type::to_char_type(c);
+				width += Utf8Width({&ch, 1});
+				if (target != nullptr)
+				{
+					return target->sputc(ch);
+				}
+				held.push_back(ch);
+				return c;
+			}
 
-					if (ch == '}')
-					{
-						if (it != end && *it == '}') // Treat as escape character for }}
-						{
-							++it;
-						}
-						else
-						{
-							FormatError();
-						}
-					}
+			std::streamsize xsputn(const char * s, std::streamsize count) override
+			{
+				width += Utf8Width({s, static_cast<size_t>(count)});
+				if (target != nullptr)
+				{
+					return target->sputn(s, count);
+				}
+				held.append(s, static_cast<size_t>(count));
+				return count;
+			}
+		};
+
+		// streams the argument into buffer using the formatting state of str, the error state it sets is kept
+		inline void StreamInto(std::ostream & str, std::streambuf & buffer, const StreamFunction & function, const std::string & format)
+		{
+			std::streambuf * original = str.rdbuf(&buffer);
+			try
+			{
+				function(str, format);
+			}
+			catch (...)
+			{
+				const auto state = str.rdstate();
+				(void) str.rdbuf(original);
+				str.clear(state);
+				throw;
+			}
+			const auto state = str.rdstate();
+			(void) str.rdbuf(original);
+			str.clear(state);
+		}
+
+		inline void Pad(std::ostream & str, size_t padding)
+		{
+			std::array<char, PadBlockSize> fill {};
+			fill.fill(str.fill());
+			while (padding != 0 && str.good())
+			{
+				const auto size = static_cast<std::streamsize>(std::min(padding, fill.size()));
+				if (str.rdbuf()->sputn(fill.data(), size) != size)
+				{
+					str.setstate(std::ios_base::badbit);
+				}
+				padding -= static_cast<size_t>(size);
+			}
+		}
+
+		// width applies to the whole argument, which is streamed once with the formatting state of str
+		// a right justified argument is held and measured, then written after the padding
+		inline void AppendPadded(std::ostream & str, const StreamFunction & function, const std::string & format, size_t width, bool leftJustify)
+		{
+			const std::ostream::sentry sentry(str);
+			if (!sentry)
+			{
+				return;
+			}
+
+			WidthCounter counter {leftJustify ? str.rdbuf() : nullptr};
+			StreamInto(str, counter, function, format);
+			if (counter.Width() < width)
+			{
+				Pad(str, width - counter.Width());
+			}
+			if (!leftJustify && str.good() && !counter.WriteHeld(*str.rdbuf()))
+			{
+				str.setstate(std::ios_base::badbit);
+			}
+		}
+
+		// appends to a string, e.g. one allocated from an arena, without the copy made by std::ostringstream::str
+		template <typename String>
+		class StringStreamBuffer : public std::streambuf
+		{
+			String & out;
 
-					if (ch == '{')
+		public:
+			explicit StringStreamBuffer(String & out)
+				: out(out)
+			{}
+
+		protected:
+			int_type overflow(int_type c) override
+			{
+				if (!traits_type::eq_int_type(c, traits_type::eof()))
+				{
+					out.push_back(traits_type::to_char_type(c));
+				}
+				return traits_type::not_eof(c);
+			}
+
+			std::streamsize xsputn(const char * s, std::streamsize count) override
+			{
+				out.append(s, static_cast<size_t>(count));
+				return count;
+			}
+		};
+
+		inline bool IsDigit(char c)
+		{
+			return c >= '0' && c <= '9';
+		}
+
+		inline bool IsNameStart(char c)
+		{
+			return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+		}
+
+		inline bool IsNameChar(char c)
+		{
+			return IsNameStart(c) || IsDigit(c);
+		}
+
+		// parses literal text and format items: {index|name[,[-]width][:format]}
+		// resolver maps a name to an argument index, onLiteral receives unescaped literal runs
+		template <typename Resolver, typename OnLiteral, typename OnArgument>
+		void ParseFormat(std::string_view view, const Resolver & resolver, const OnLiteral & onLiteral, const OnArgument & onArgument)
+		{
+			constexpr auto DecimalShift = 10;
+			const size_t end = view.size();
+			size_t literalStart {};
+
+			for (size_t pos = 0; pos != end;)
+			{
+				char ch = view[pos];
+				if (ch == '}')
+				{
+					if (pos + 1 == end || view[pos + 1] != '}') // Treat as escape character for }}
 					{
-						if (it != end && *it == '{') // Treat as escape character for {{
-						{
-							++it;
-						}
-						else
-						{
-							--it;
-							break;
-						}
+						FormatError();
 					}
+					onLiteral(view.substr(literalStart, pos + 1 - literalStart));
+					pos += 2;
+					literalStart = pos;
+					continue;
+				}
 
-					str << ch;
+				if (ch != '{')
+				{
+					++pos;
+					continue;
 				}
 
-				if (it == end)
+				if (pos + 1 != end && view[pos + 1] == '{') // Treat as escape character for {{
 				{
-					break;
+					onLiteral(view.substr(literalStart, pos + 1 - literalStart));
+					pos += 2;
+					literalStart = pos;
+					continue;
 				}
-				++it;
-				if (it == end || (ch = *it) < '0' || ch > '9')
+
+				if (pos != literalStart)
+				{
+					onLiteral(view.substr(literalStart, pos - literalStart));
+				}
+
+				if (++pos == end)
 				{
 					FormatError();
 				}
 
 				size_t index {};
-				do
+				ch = view[pos];
+				if (IsDigit(ch))
 				{
-					index = index * DecimalShift + ch - '0';
-					++it;
-					if (it == end)
+					do
 					{
-						FormatError();
-					}
-					ch = *it;
-				} while (ch >= '0' && ch <= '9');
+						index = index * DecimalShift + ch - '0';
+						if (++pos == end)
+						{
+							FormatError();
+						}
+						ch = view[pos];
+					} while (IsDigit(ch));
+				}
+				else if (IsNameStart(ch))
+				{
+					const size_t nameStart = pos;
+					do
+					{
+						if (++pos == end)
+						{
+							FormatError();
+						}
+						ch = view[pos];
+					} while (IsNameChar(ch));
+					index = resolver(view.substr(nameStart, pos - nameStart));
+				}
+				else
+				{
+					FormatError();
+				}
 
-				while (it != end && (ch = *it) == ' ')
+				while (pos != end && (ch = view[pos]) == ' ')
 				{
-					++it;
+					++pos;
 				}
 
 				bool leftJustify = {};
 				size_t width {};
 				if (ch == ',')
 				{
-					++it;
-					while (it != end && *it == ' ')
+					++pos;
+					while (pos != end && view[pos] == ' ')
 					{
-						++it;
+						++pos;
 					}
 
-					if (it == end)
+					if (pos == end)
 					{
 						FormatError();
 					}
 
-					ch = *it;
+					ch = view[pos];
 					if (ch == '-')
 					{
 						leftJustify = true;
-						++it;
-						if (it == end)
+						if (++pos == end)
 						{
 							FormatError();
 						}
-						ch = *it;
+						ch = view[pos];
 					}
 
-					if (ch < '0' || ch > '9')
+					if (!IsDigit(ch))
 					{
 						FormatError();
 					}
@@ -143,77 +332,217 @@ namespace GLib
 					do
 					{
 						width = width * DecimalShift + ch - '0';
-						++it;
-						if (it == end)
+						if (++pos == end)
 						{
 							FormatError();
 						}
-						ch = *it;
-					} while (ch >= '0' && ch <= '9');
+						ch = view[pos];
+					} while (IsDigit(ch));
 				}
 
-				while (it != end && (ch = *it) == ' ')
+				while (pos != end && (ch = view[pos]) == ' ')
 				{
-					++it;
+					++pos;
 				}
 
-				std::string format; // use strng_view?
-
+				std::string format;
 				if (ch == ':')
 				{
-					std::ostringstream tmp; // capture a string_view
-					++it;
-					for (;;)
+					for (++pos;;)
 					{
-						if (it == end)
+						if (pos == end)
 						{
 							FormatError();
 						}
-						ch = *it;
-						++it;
+						ch = view[pos++];
 						if (ch == '{')
 						{
-							if (it != end && *it == '{') // Treat as escape character for {{
-							{
-								++it;
-							}
-							else
+							if (pos == end || view[pos] != '{') // Treat as escape character for {{
 							{
 								FormatError();
 							}
+							++pos;
 						}
 						else if (ch == '}')
 						{
-							if (it != end && *it == '}') // Treat as escape character for }}
-							{
-								++it;
-							}
-							else
+							if (pos == end || view[pos] != '}') // Treat as escape character for }}
 							{
-								--it;
+								--pos;
 								break;
 							}
+							++pos;
 						}
 
-						tmp << ch;
+						format += ch;
 					}
-
-					format = tmp.str();
 				}
+
 				if (ch != '}')
 				{
 					FormatError();
 				}
-				++it;
+				literalStart = ++pos;
+
+				onArgument(index, width, leftJustify, format);
+			}
+
+			if (literalStart != end)
+			{
+				onLiteral(view.substr(literalStart));
+			}
+		}
+
+		inline void Write(std::ostream & str, std::string_view value)
+		{
+			(void) str.write(value.data(), static_cast<std::streamsize>(value.size()));
+		}
+
+		inline void AppendArgument(std::ostream & str, const Span<StreamFunction> & args, size_t index, size_t width, bool leftJustify,
+															 const std::string & format)
+		{
+			const StreamFunction & function = args.at(static_cast<Span<StreamFunction>::index_type>(index));
+			if (width == 0)
+			{
+				function(str, format);
+				return;
+			}
+			AppendPadded(str, function, format, width, leftJustify);
+		}
+
+		inline std::ostream & AppendFormatHelper(std::ostream & str, const std::string_view & view, const Span<StreamFunction> & args)
+		{
+			ParseFormat(
+				view,
+				[](std::string_view) -> size_t {
+					FormatError();
+					return 0;
+				},
+				[&](std::string_view literal) { Write(str, literal); },
+				[&](size_t index, size_t width, bool leftJustify, const std::string & format) {
+					AppendArgument(str, args, index, width, leftJustify, format);
+				});
+			return str;
+		}
+	}
+
+	// argument names by position, resolved to indices once by PreparedFormat
+	class FormatNames
+	{
+		std::vector<std::string> names;
+
+	public:
+		FormatNames() = default;
+
+		FormatNames(std::initializer_list<std::string_view> names)
+		{
+			for (auto name : names)
+			{
+				this->names.emplace_back(name);
+			}
+		}
+
+		size_t IndexOf(std::string_view name) const
+		{
+			auto it = std::find(names.begin(), names.end(), name);
+			if (it == names.end())
+			{
+				throw std::logic_error("Unknown argument name : " + std::string(name));
+			}
+			return static_cast<size_t>(it - names.begin());
+		}
+
+		size_t size() const
+		{
+			return names.size();
+		}
+	};
+
+	// format parsed once with names resolved to argument indices, apply with FormatterT::Format
+	// applying it only indexes the arguments, keep it e.g. as a static for a log line that uses names
+	class PreparedFormat
+	{
+	public:
+		struct Item
+		{
+			std::string literal;
+			bool isArgument {};
+			size_t index {};
+			size_t width {};
+			bool leftJustify {};
+			std::string format;
+		};
+
+	private:
+		std::vector<Item> items;
+
+	public:
+		// without names every name is unknown
+		explicit PreparedFormat(std::string_view format)
+		{
+			Parse(format, [](std::string_view name) -> size_t { throw std::logic_error("Unknown argument name : " + std::string(name)); });
+		}
+
+		PreparedFormat(std::string_view format, const FormatNames & names)
+		{
+			Parse(format, [&](std::string_view name) { return names.IndexOf(name); });
+		}
 
-				if (width != 0)
+		const std::vector<Item> & Items() const
+		{
+			return items;
+		}
+
+	private:
+		template <typename Resolver>
+		void Parse(std::string_view format, const Resolver & resolver)
+		{
+			FormatterDetail::ParseFormat(
+				format, resolver,
+				[&](std::string_view literal) {
+					if (items.empty() || items.back().isArgument)
+					{
+						items.emplace_back();
+					}
+					items.back().literal += literal;
+				},
+				[&](size_t index, size_t width, bool leftJustify, const std::string & format) {
+					items.push_back({{}, true, index, width, leftJustify, format});
+				});
+		}
+	};
+
+	namespace FormatterDetail
+	{
+		inline void AppendPrepared(std::ostream & str, const PreparedFormat & format, const Span<StreamFunction> & args)
+		{
+			for (const auto & item : format.Items())
+			{
+				if (item.isArgument)
 				{
-					str << (leftJustify ? std::left : std::right) << std::setw(width);
+					AppendArgument(str, args, item.index, item.width, item.leftJustify, item.format);
 				}
+				else
+				{
+					Write(str, item.literal);
+				}
+			}
+		}
+
+		template <typename Column>
+		size_t ColumnSize(const Column & column)
+		{
+			return static_cast<size_t>(column.size());
+		}
 
-				args[index](str, format);
+		template <typename First, typename... Rest>
+		size_t RowCount(const First & first, const Rest &... rest)
+		{
+			const size_t rows = ColumnSize(first);
+			if (((ColumnSize(rest) != rows) || ...))
+			{
+				throw std::logic_error("Column sizes differ");
 			}
-			return str;
+			return rows;
 		}
 	}
 
@@ -236,6 +565,17 @@ namespace GLib
 			return str.str();
 		}
 
+		// result allocated from resource e.g. Util::ThreadArenaResource() for transient messages
+		template <typename... Ts>
+		static std::pmr::string Format(std::pmr::memory_resource * resource, const char * format, const Ts &... ts)
+		{
+			std::pmr::string result {resource};
+			FormatterDetail::StringStreamBuffer<std::pmr::string> buffer {result};
+			std::ostream str {&buffer};
+			Format(str, format, ts...);
+			return result;
+		}
+
 		template <typename... Ts>
 		static std::string Format(const char * format)
 		{
@@ -243,6 +583,46 @@ namespace GLib
 			throw std::logic_error("NoArguments");
 		}
 
+		template <typename... Ts>
+		static std::ostream & Format(std::ostream & str, const PreparedFormat & format, const Ts &... ts)
+		{
+			std::array<FormatterDetail::StreamFunction, sizeof...(Ts)> ar {ToStreamFunctions(ts)...};
+			FormatterDetail::AppendPrepared(str, format, {ar.data(), ar.size()});
+			return str;
+		}
+
+		template <typename... Ts>
+		static std::string Format(const PreparedFormat & format, Ts &&... ts)
+		{
+			std::ostringstream str;
+			Format(str, format, std::forward<Ts>(ts)...);
+			return str.str();
+		}
+
+		// applies the format once per row, argument n of each row is element [row] of column n
+		template <typename... Columns>
+		static std::ostream & FormatRows(std::ostream & str, const PreparedFormat & format, const Columns &... columns)
+		{
+			static_assert(sizeof...(Columns) != 0, "No columns");
+			const size_t rows = FormatterDetail::RowCount(columns...);
+
+			size_t row {};
+			std::array<FormatterDetail::StreamFunction, sizeof...(Columns)> ar {ToColumnFunction(columns, row)...};
+			for (; row != rows; ++row)
+			{
+				FormatterDetail::AppendPrepared(str, format, {ar.data(), ar.size()});
+			}
+			return str;
+		}
+
+		template <typename... Columns>
+		static std::string FormatRows(const PreparedFormat & format, const Columns &... columns)
+		{
+			std::ostringstream str;
+			FormatRows(str, format, columns...);
+			return str.str();
+		}
+
 	private:
 		// ? http://www.drdobbs.com/cpp/efficient-use-of-lambda-expressions-and/232500059
 		template <typename T>
@@ -251,6 +631,14 @@ namespace GLib
 			return FormatterDetail::StreamFunction([&](std::ostream & stm, const std::string & format) { FormatImpl(stm, t, format, 0); });
 		}
 
+		template <typename Column>
+		static FormatterDetail::StreamFunction ToColumnFunction(const Column & column, const size_t & row)
+		{
+			return FormatterDetail::StreamFunction([&column, &row](std::ostream & stm, const std::string & format) {
+				FormatImpl(stm, column[static_cast<typename Column::size_type>(row)], format, 0);
+			});
+		}
+
 		template <typename T>
 		static auto FormatImpl(std::ostream & os, const T & obj, const std::string & format, int unused)
 			-> decltype(Policy::Format(os, obj, format), void())
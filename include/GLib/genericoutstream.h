@@ -1,14 +1,15 @@
 #pragma once
 
 #include <ostream>
+#include <utility>
 
 namespace GLib::Util
 {
 	template <typename T, typename BufferType>
 	class GenericOutStream
 	{
-		std::basic_ostream<T> stream;
 		BufferType buffer;
+		std::basic_ostream<T> stream;
 
 	public:
 		explicit GenericOutStream(std::ios_base::fmtflags flags = {})
@@ -17,6 +18,15 @@ namespace GLib::Util
 			stream.setf(flags);
 		}
 
+		// buffers that need arguments e.g. SpanStreamBuffer over a caller's buffer
+		template <typename... Args>
+		explicit GenericOutStream(std::ios_base::fmtflags flags, Args &&... args)
+			: buffer(std::forward<Args>(args)...)
+			, stream(&buffer)
+		{
+			stream.setf(flags);
+		}
+
 		std::basic_ostream<T> & Stream()
 		{
 			return stream;
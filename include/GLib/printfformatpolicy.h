@@ -1,6 +1,7 @@
 #ifndef PRINTF_FORMAT_POLICY_H
 #define PRINTF_FORMAT_POLICY_H
 
+#include <GLib/LocaleFormat.h>
 #include <GLib/compat.h>
 #include <GLib/cvt.h>
 #include <GLib/stackorheap.h>
@@ -44,10 +45,14 @@ namespace GLib
 				std::string f = CheckFormat(defaultFormat, format);
 				constexpr auto InitialBufferSize = 21;
 				Util::StackOrHeap<char, InitialBufferSize> s;
-				const int len = ::snprintf(nullptr, 0, f.c_str(), value); // NOLINT(cppcoreguidelines-pro-type-vararg,hicpp-vararg) by design
+				// most values fit the stack buffer so are formatted once, otherwise the returned length is used for a second pass
+				const int len = ::snprintf(s.Get(), s.size(), f.c_str(), value); // NOLINT(cppcoreguidelines-pro-type-vararg,hicpp-vararg) by design
 				Compat::AssertTrue(len >= 0, "snprintf", errno);
-				s.EnsureSize(static_cast<size_t>(len) + 1);
-				::snprintf(s.Get(), s.size(), f.c_str(), value); // NOLINT(cppcoreguidelines-pro-type-vararg,hicpp-vararg) by design
+				if (static_cast<size_t>(len) >= s.size())
+				{
+					s.EnsureSize(static_cast<size_t>(len) + 1);
+					::snprintf(s.Get(), s.size(), f.c_str(), value); // NOLINT(cppcoreguidelines-pro-type-vararg,hicpp-vararg) by design
+				}
 
 				stm << s.Get();
 			}
@@ -56,10 +61,19 @@ namespace GLib
 			inline void ToStringImpl(const char * defaultFormat, std::ostream & stm, const std::tm & value, const std::string & format)
 			{
 				std::string f = CheckFormat(defaultFormat, format);
-				// stream to wide to correctly convert locale symbols, is there a better better way? maybe when code convert gets fixed
+				std::string result;
+				if (LocaleFormat::FormatTime(result, value, f, stm.getloc()))
+				{
+					stm << result;
+					return;
+				}
+
+				// uncommon specifiers, stream to wide to correctly convert locale symbols
 				std::wstringstream wideStream;
 				(void) wideStream.imbue(stm.getloc());
-				wideStream << std::put_time(&value, Cvt::a2w(f).c_str());
+				Util::WideCharBuffer wideFormat;
+				(void) Cvt::a2w(f, wideFormat);
+				wideStream << std::put_time(&value, wideFormat.Get());
 				stm << Cvt::w2a(wideStream.str());
 			}
 
@@ -68,11 +82,9 @@ namespace GLib
 			{
 				(void) defaultFormat;
 				CheckFormatEmpty(format);
-				// stream to wide to correctly convert locale symbols, is there a better better way? maybe when code convert gets fixed
-				std::wstringstream wideStream;
-				(void) wideStream.imbue(stm.getloc());
-				wideStream << std::showbase << std::put_money(value.value);
-				stm << Cvt::w2a(wideStream.str());
+				std::string result;
+				LocaleFormat::FormatMoney(result, value.value, stm.getloc(), stm.fill());
+				stm << result;
 			}
 
 			template <size_t>
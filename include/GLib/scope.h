@@ -1,6 +1,13 @@
 #ifndef SCOPE_H
 #define SCOPE_H
 
+#include <GLib/stackorheap.h>
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
 #include <utility>
 
 namespace GLib::Detail
@@ -12,7 +19,7 @@ namespace GLib::Detail
 
 	public:
 		explicit ScopedFunction(Function function)
-			: function(function)
+			: function(std::move(function))
 		{}
 
 		ScopedFunction(const ScopedFunction &) = delete;
@@ -33,6 +40,127 @@ namespace GLib::Detail
 	}
 }
 
+namespace GLib
+{
+	// many scope exit actions in one object, run in reverse order of registration when the stack is destroyed
+	// function objects up to the inline buffer size are stored without allocating, larger ones or overflow go to the heap
+	// actions must be noexcept, if registration fails the action is run immediately and the exception rethrown
+	// Dismiss for transactional code: register the rollback of each step then dismiss them all once every step has succeeded
+	template <size_t InlineCount = 16>
+	class ScopeStack
+	{
+		static constexpr size_t InlineBytes = InlineCount * 4 * sizeof(void *);
+
+		struct Entry
+		{
+			void (*exit)(void * function, bool run) noexcept;
+			void * function;
+		};
+
+		alignas(std::max_align_t) std::array<std::byte, InlineBytes> buffer {};
+		size_t used {};
+		Util::SmallVector<Entry, InlineCount> entries;
+
+	public:
+		ScopeStack() = default;
+		ScopeStack(const ScopeStack &) = delete;
+		ScopeStack & operator=(const ScopeStack &) = delete;
+		ScopeStack(ScopeStack &&) = delete;
+		ScopeStack & operator=(ScopeStack &&) = delete;
+
+		~ScopeStack()
+		{
+			Unwind(true);
+		}
+
+		template <typename Function>
+		void Push(Function && function)
+		{
+			using Stored = std::decay_t<Function>;
+			static_assert(std::is_nothrow_invocable_v<Stored &>, "Scope exit actions must be noexcept");
+
+			try
+			{
+				if (entries.size() == entries.capacity())
+				{
+					entries.reserve(entries.capacity() * 2);
+				}
+				entries.push_back(Store<Stored>(std::forward<Function>(function)));
+			}
+			catch (...)
+			{
+				function();
+				throw;
+			}
+		}
+
+		size_t Size() const noexcept
+		{
+			return entries.size();
+		}
+
+		// runs the actions now in reverse order
+		void Run() noexcept
+		{
+			Unwind(true);
+		}
+
+		// discards the actions without running them
+		void Dismiss() noexcept
+		{
+			Unwind(false);
+		}
+
+	private:
+		template <typename Stored, typename Function>
+		Entry Store(Function && function)
+		{
+			void * p = buffer.data() + used; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) used <= InlineBytes
+			size_t space = InlineBytes - used;
+			if (std::align(alignof(Stored), sizeof(Stored), p, space) != nullptr)
+			{
+				::new (p) Stored(std::forward<Function>(function));
+				used = InlineBytes - space + sizeof(Stored);
+				return {&ExitInline<Stored>, p};
+			}
+			return {&ExitHeap<Stored>, new Stored(std::forward<Function>(function))}; // NOLINT(cppcoreguidelines-owning-memory) owned by the entry
+		}
+
+		template <typename Stored>
+		static void ExitInline(void * function, bool run) noexcept
+		{
+			auto * stored = static_cast<Stored *>(function);
+			if (run)
+			{
+				(*stored)();
+			}
+			stored->~Stored();
+		}
+
+		template <typename Stored>
+		static void ExitHeap(void * function, bool run) noexcept
+		{
+			auto * stored = static_cast<Stored *>(function);
+			if (run)
+			{
+				(*stored)();
+			}
+			delete stored; // NOLINT(cppcoreguidelines-owning-memory) owned by the entry
+		}
+
+		void Unwind(bool run) noexcept
+		{
+			for (size_t i = entries.size(); i != 0; --i)
+			{
+				const Entry & entry = entries[i - 1];
+				entry.exit(entry.function, run);
+			}
+			entries.clear();
+			used = 0;
+		}
+	};
+}
+
 #define SCOPE_IMPL(name, line, func) /*NOLINT*/                                                                                            \
 	const auto & name##line = GLib::Detail::Scope(func);                                                                                     \
 	(void) name##line;
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <climits>
+#include <cstdint>
+#include <streambuf>
+#include <string_view>
+#include <type_traits>
+
+namespace GLib::Util
+{
+	// non-owning put area over a caller's buffer e.g. a char[N] or mapped memory, never allocates
+	// output past the end is dropped and reported by Truncated, the stream also sets badbit
+	template <typename T>
+	class SpanStreamBuffer : public std::basic_streambuf<T>
+	{
+		using Base = std::basic_streambuf<T>;
+
+		bool truncated {};
+
+	public:
+		using typename Base::int_type;
+		using typename Base::traits_type;
+
+		SpanStreamBuffer(T * data, size_t size)
+		{
+			this->setp(data, data + size); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) caller's buffer
+		}
+
+		template <size_t N>
+		explicit SpanStreamBuffer(T (&data)[N]) // NOLINT(cppcoreguidelines-avoid-c-arrays,hicpp-avoid-c-arrays,modernize-avoid-c-arrays)
+			: SpanStreamBuffer(data, N)
+		{}
+
+		std::basic_string_view<T> Get() const
+		{
+			return {this->pbase(), Size()};
+		}
+
+		size_t Size() const
+		{
+			return static_cast<size_t>(this->pptr() - this->pbase());
+		}
+
+		size_t Capacity() const
+		{
+			return static_cast<size_t>(this->epptr() - this->pbase());
+		}
+
+		bool Truncated() const
+		{
+			return truncated;
+		}
+
+		// the stream's state should also be cleared
+		void Reset()
+		{
+			this->setp(this->pbase(), this->epptr());
+			truncated = false;
+		}
+
+	protected:
+		int_type overflow(int_type c) override
+		{
+			if (traits_type::eq_int_type(c, traits_type::eof()))
+			{
+				return traits_type::not_eof(c);
+			}
+			truncated = true;
+			return traits_type::eof();
+		}
+
+		std::streamsize xsputn(const T * s, std::streamsize count) override
+		{
+			const auto room = static_cast<std::streamsize>(this->epptr() - this->pptr());
+			const std::streamsize written = std::min(count, room);
+			traits_type::copy(this->pptr(), s, static_cast<size_t>(written));
+			for (std::streamsize remaining = written; remaining != 0;)
+			{
+				const int step = static_cast<int>(std::min<std::streamsize>(remaining, INT_MAX));
+				this->pbump(step);
+				remaining -= step;
+			}
+			truncated = truncated || written != count;
+			return written;
+		}
+	};
+
+	// the same bounded output without iostreams or locales, e.g. for signal handlers and crash reporting
+	// numbers are formatted with std::to_chars, anything that does not fit is dropped and reported by Truncated
+	class SpanWriter
+	{
+		static constexpr size_t MaxNumberSize = 64;
+		static constexpr int PointerBase = 16;
+
+		char * begin;
+		char * ptr;
+		char * end;
+		bool truncated {};
+
+	public:
+		SpanWriter(char * data, size_t size)
+			: begin(data)
+			, ptr(data)
+			, end(data + size) // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) caller's buffer
+		{}
+
+		template <size_t N>
+		explicit SpanWriter(char (&data)[N]) // NOLINT(cppcoreguidelines-avoid-c-arrays,hicpp-avoid-c-arrays,modernize-avoid-c-arrays)
+			: SpanWriter(data, N)
+		{}
+
+		std::string_view Get() const noexcept
+		{
+			return {begin, Size()};
+		}
+
+		size_t Size() const noexcept
+		{
+			return static_cast<size_t>(ptr - begin);
+		}
+
+		size_t Capacity() const noexcept
+		{
+			return static_cast<size_t>(end - begin);
+		}
+
+		bool Truncated() const noexcept
+		{
+			return truncated;
+		}
+
+		void Reset() noexcept
+		{
+			ptr = begin;
+			truncated = false;
+		}
+
+		SpanWriter & Write(std::string_view value) noexcept
+		{
+			const size_t written = std::min(value.size(), static_cast<size_t>(end - ptr));
+			ptr = std::copy_n(value.data(), written, ptr);
+			truncated = truncated || written != value.size();
+			return *this;
+		}
+
+		SpanWriter & operator<<(std::string_view value) noexcept
+		{
+			return Write(value);
+		}
+
+		SpanWriter & operator<<(const char * value) noexcept
+		{
+			return Write(value);
+		}
+
+		SpanWriter & operator<<(char value) noexcept
+		{
+			return Write({&value, 1});
+		}
+
+		// as iostreams without boolalpha
+		SpanWriter & operator<<(bool value) noexcept
+		{
+			return Write(value ? "1" : "0");
+		}
+
+		template <typename Number, typename = std::enable_if_t<std::is_arithmetic_v<Number>>>
+		SpanWriter & operator<<(Number value) noexcept
+		{
+			std::array<char, MaxNumberSize> number {};
+			const auto result = std::to_chars(number.data(), number.data() + number.size(), value); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) array end
+			return Write({number.data(), static_cast<size_t>(result.ptr - number.data())});
+		}
+
+		SpanWriter & operator<<(const void * value) noexcept
+		{
+			std::array<char, MaxNumberSize> number {};
+			const auto result = std::to_chars(number.data(), number.data() + number.size(), reinterpret_cast<uintptr_t>(value), // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast,cppcoreguidelines-pro-bounds-pointer-arithmetic) address value
+																				PointerBase);
+			return Write("0x").Write({number.data(), static_cast<size_t>(result.ptr - number.data())});
+		}
+	};
+}
@@ -1,12 +1,19 @@
 #pragma once
 
+#include <GLib/ByteSet.h>
+
 #include <algorithm>
 #include <iterator>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 
 namespace GLib::Util
 {
+	struct NonOwningTag
+	{};
+	constexpr NonOwningTag NonOwning {};
+
 	namespace Detail
 	{
 		template <typename CharType>
@@ -24,46 +31,59 @@ namespace GLib::Util
 			return L",";
 		}
 
+		// tokens are views into the split value, owned (copied) unless constructed with NonOwning
 		template <typename StringType>
 		class Splitter
 		{
 			using T = typename StringType::value_type;
-			StringType value;
+			using ViewType = std::basic_string_view<T>;
+
+			StringType storage;
+			ViewType external;
+			bool owning;
 			StringType delimiter;
 
 		public:
 			Splitter(StringType value, const StringType & delimiter = DefaultDelimiter<typename StringType::value_type>())
-				: value(move(value))
+				: storage(move(value))
+				, owning(true)
 				, delimiter(delimiter)
 			{
-				if (delimiter.empty())
-				{
-					throw std::logic_error("Delimiter is empty");
-				}
+				CheckDelimiter();
+			}
+
+			Splitter(NonOwningTag /*unused*/, ViewType value, const StringType & delimiter = DefaultDelimiter<typename StringType::value_type>())
+				: external(value)
+				, owning(false)
+				, delimiter(delimiter)
+			{
+				CheckDelimiter();
 			}
 
 			class iterator
 			{
-				const Splitter * const splitter;
+				const Splitter * splitter;
+				ViewType value;
 				std::size_t current, nextDelimiter;
 
 			public:
 				using iterator_category = std::forward_iterator_tag;
-				using value_type = StringType;
+				using value_type = ViewType;
 				using difference_type = void;
 				using pointer = void;
 				using reference = void;
 
 				iterator(const Splitter & splitter)
 					: splitter(&splitter)
+					, value(splitter.Value())
 					, current(0)
-					, nextDelimiter(splitter.value.find(splitter.delimiter, 0))
+					, nextDelimiter(value.find(splitter.delimiter, 0))
 				{}
 
 				iterator()
 					: splitter()
-					, current(StringType::npos)
-					, nextDelimiter(StringType::npos)
+					, current(ViewType::npos)
+					, nextDelimiter(ViewType::npos)
 				{}
 
 				bool operator==(const iterator & it) const
@@ -78,10 +98,10 @@ namespace GLib::Util
 
 				iterator operator++()
 				{
-					if (nextDelimiter != StringType::npos)
+					if (nextDelimiter != ViewType::npos)
 					{
 						current = nextDelimiter + splitter->delimiter.size();
-						nextDelimiter = splitter->value.find(splitter->delimiter, current);
+						nextDelimiter = value.find(splitter->delimiter, current);
 					}
 					else
 					{
@@ -91,10 +111,10 @@ namespace GLib::Util
 					return *this;
 				}
 
-				StringType operator*() const
+				ViewType operator*() const
 				{
-					auto end = nextDelimiter != StringType::npos ? nextDelimiter : splitter->value.size();
-					return splitter->value.substr(current, end - current);
+					auto end = nextDelimiter != ViewType::npos ? nextDelimiter : value.size();
+					return value.substr(current, end - current);
 				}
 			};
 
@@ -107,6 +127,20 @@ namespace GLib::Util
 			{
 				return iterator();
 			}
+
+		private:
+			ViewType Value() const
+			{
+				return owning ? ViewType {storage} : external;
+			}
+
+			void CheckDelimiter() const
+			{
+				if (delimiter.empty())
+				{
+					throw std::logic_error("Delimiter is empty");
+				}
+			}
 		};
 	}
 
@@ -117,8 +151,8 @@ namespace GLib::Util
 	void Split(const StringType & value, OutputIterator it,
 						 const StringType & delimiter = Detail::DefaultDelimiter<typename StringType::value_type>())
 	{
-		Detail::Splitter<StringType> splitter {value, delimiter};
-		std::copy(splitter.begin(), splitter.end(), it);
+		Detail::Splitter<StringType> splitter {NonOwning, value, delimiter};
+		std::transform(splitter.begin(), splitter.end(), it, [](auto token) { return StringType {token}; });
 	}
 
 	template <typename Predicate, typename OutYes, typename OutNo>
@@ -140,4 +174,27 @@ namespace GLib::Util
 			it = trueStart;
 		}
 	}
+
+	// as above using a vectorised scan for the byte class
+	template <typename OutYes, typename OutNo>
+	inline void Split(const std::string_view & value, const ByteSet & set, OutYes outYes, OutNo outNo)
+	{
+		for (size_t pos = 0; pos < value.size();)
+		{
+			size_t falseStart = FindFirstNotOf(value, set, pos);
+			falseStart = falseStart == std::string_view::npos ? value.size() : falseStart;
+			if (falseStart != pos)
+			{
+				outYes(value.substr(pos, falseStart - pos));
+			}
+
+			size_t trueStart = FindFirstOf(value, set, falseStart);
+			trueStart = trueStart == std::string_view::npos ? value.size() : trueStart;
+			if (trueStart != falseStart)
+			{
+				outNo(value.substr(falseStart, trueStart - falseStart));
+			}
+			pos = trueStart;
+		}
+	}
 }
\ No newline at end of file
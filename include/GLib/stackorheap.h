@@ -1,8 +1,13 @@
 #ifndef STACK_OR_HEAP_H
 #define STACK_OR_HEAP_H
 
+#include <algorithm>
 #include <array>
+#include <functional>
+#include <iterator>
 #include <memory>
+#include <type_traits>
+#include <utility>
 #include <variant>
 
 namespace GLib::Util
@@ -21,17 +26,59 @@ namespace GLib::Util
 		StackOrHeap() = default;
 		StackOrHeap(const StackOrHeap &) = delete;
 		StackOrHeap & operator=(const StackOrHeap &) = delete;
-		StackOrHeap(StackOrHeap &&) = delete;
-		StackOrHeap & operator=(StackOrHeap &&) = delete;
+
+		// the moved from object is left with empty stack storage
+		StackOrHeap(StackOrHeap && other) noexcept(std::is_nothrow_move_constructible_v<T>)
+			: heapSize(std::exchange(other.heapSize, 0))
+			, storage(std::move(other.storage))
+		{
+			other.storage.template emplace<Stack>();
+		}
+
+		StackOrHeap & operator=(StackOrHeap && other) noexcept(std::is_nothrow_move_assignable_v<T>)
+		{
+			if (this != &other)
+			{
+				heapSize = std::exchange(other.heapSize, 0);
+				storage = std::move(other.storage);
+				other.storage.template emplace<Stack>();
+			}
+			return *this;
+		}
+
 		~StackOrHeap() = default;
 
+		// for scratch buffers, existing elements are discarded when the storage is replaced
 		void EnsureSize(size_t newElementCount)
 		{
-			if ((newElementCount > StackElementCount && !HeapInUse()) || (HeapInUse() && newElementCount > heapSize))
+			if (newElementCount > GetSize())
 			{
 				AllocateHeap(newElementCount);
 			}
-			// could go back to stack if (heapInUse && newElementCount <= StackElementCount)
+		}
+
+		// existing elements are moved to the new storage
+		void EnsureSizeKeepingContents(size_t newElementCount)
+		{
+			if (newElementCount > GetSize())
+			{
+				Heap heap = MakeHeap(newElementCount);
+				std::move(Get(), Get() + std::min(GetSize(), newElementCount), heap.get()); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) current storage
+				storage = std::move(heap);
+				heapSize = newElementCount;
+			}
+		}
+
+		// moves the first elementCount elements back to the stack when they fit, releasing the heap
+		void Shrink(size_t elementCount)
+		{
+			if (HeapInUse() && elementCount <= StackElementCount)
+			{
+				Heap heap = std::move(std::get<Heap>(storage));
+				Stack & stack = storage.template emplace<Stack>();
+				std::move(heap.get(), heap.get() + elementCount, stack.data()); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) elementCount <= heapSize
+				heapSize = 0;
+			}
 		}
 
 		size_t size() const
@@ -60,15 +107,170 @@ namespace GLib::Util
 			return HeapInUse() ? heapSize : StackElementCount;
 		}
 
+		static Heap MakeHeap(size_t size)
+		{
+			return std::make_unique<T[]>(size); // NOLINT(cppcoreguidelines-avoid-c-arrays,hicpp-avoid-c-arrays,modernize-avoid-c-arrays)
+		}
+
 		void AllocateHeap(size_t size)
 		{
-			storage = std::make_unique<T[]>(size); // NOLINT(cppcoreguidelines-avoid-c-arrays,hicpp-avoid-c-arrays,modernize-avoid-c-arrays)
+			storage = MakeHeap(size);
 			heapSize = size;
 		}
 	};
 
+	// vector holding up to StackElementCount elements without allocating, e.g. for building strings that usually fit on the stack
+	// capacity grows geometrically keeping the contents, shrink_to_fit returns to the stack when the contents fit
+	template <typename T, size_t StackElementCount>
+	class SmallVector
+	{
+		StackOrHeap<T, StackElementCount> buffer;
+		size_t count {};
+
+	public:
+		using value_type = T;
+		using iterator = T *;
+		using const_iterator = const T *;
+
+		SmallVector() = default;
+		SmallVector(const SmallVector &) = delete;
+		SmallVector & operator=(const SmallVector &) = delete;
+
+		SmallVector(SmallVector && other) noexcept(std::is_nothrow_move_constructible_v<T>)
+			: buffer(std::move(other.buffer))
+			, count(std::exchange(other.count, 0))
+		{}
+
+		SmallVector & operator=(SmallVector && other) noexcept(std::is_nothrow_move_assignable_v<T>)
+		{
+			buffer = std::move(other.buffer);
+			count = std::exchange(other.count, 0);
+			return *this;
+		}
+
+		~SmallVector() = default;
+
+		size_t size() const noexcept
+		{
+			return count;
+		}
+
+		size_t capacity() const noexcept
+		{
+			return buffer.size();
+		}
+
+		bool empty() const noexcept
+		{
+			return count == 0;
+		}
+
+		T * data() noexcept
+		{
+			return buffer.Get();
+		}
+
+		const T * data() const noexcept
+		{
+			return buffer.Get();
+		}
+
+		iterator begin() noexcept
+		{
+			return data();
+		}
+
+		iterator end() noexcept
+		{
+			return data() + count; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) count <= capacity
+		}
+
+		const_iterator begin() const noexcept
+		{
+			return data();
+		}
+
+		const_iterator end() const noexcept
+		{
+			return data() + count; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) count <= capacity
+		}
+
+		T & operator[](size_t index) noexcept
+		{
+			return data()[index]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) unchecked as std::vector
+		}
+
+		const T & operator[](size_t index) const noexcept
+		{
+			return data()[index]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) unchecked as std::vector
+		}
+
+		void reserve(size_t elementCount)
+		{
+			buffer.EnsureSizeKeepingContents(elementCount);
+		}
+
+		void push_back(T value)
+		{
+			Grow(count + 1);
+			data()[count++] = std::move(value); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) grown above
+		}
+
+		// values may point into this vector, they are re-based after growing moves the contents
+		void append(const T * values, size_t valueCount)
+		{
+			const std::less<const T *> less;
+			const bool aliased = !less(values, data()) && less(values, data() + count); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) end of contents
+			const auto offset = aliased ? static_cast<size_t>(values - data()) : 0;
+			Grow(count + valueCount);
+			if (aliased)
+			{
+				values = data() + offset; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) offset < count
+			}
+			std::copy(values, values + valueCount, end()); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) valueCount elements
+			count += valueCount;
+		}
+
+		// any contiguous range e.g. std::basic_string_view<T>, std::vector<T>
+		template <typename Range>
+		void append(const Range & values)
+		{
+			append(std::data(values), std::size(values));
+		}
+
+		void resize(size_t elementCount)
+		{
+			Grow(elementCount);
+			if (elementCount > count)
+			{
+				std::fill(end(), begin() + elementCount, T {}); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) grown above
+			}
+			count = elementCount;
+		}
+
+		void clear() noexcept
+		{
+			count = 0;
+		}
+
+		void shrink_to_fit()
+		{
+			buffer.Shrink(count);
+		}
+
+	private:
+		void Grow(size_t elementCount)
+		{
+			if (elementCount > capacity())
+			{
+				buffer.EnsureSizeKeepingContents(std::max(elementCount, capacity() * 2));
+			}
+		}
+	};
+
 	constexpr auto DefaultStackReserveSize = 256;
 	using CharBuffer = Util::StackOrHeap<char, DefaultStackReserveSize>;
 	using WideCharBuffer = Util::StackOrHeap<wchar_t, DefaultStackReserveSize>;
+	using SmallString = Util::SmallVector<char, DefaultStackReserveSize>;
 }
 #endif // STACK_OR_HEAP_H
@@ -1,48 +1,140 @@
 #pragma once
 
+#include <algorithm>
+#include <climits>
 #include <streambuf>
+#include <string_view>
 #include <vector>
 
 namespace GLib::Util
 {
-	// convert to circular buffer
+	// growable put area, characters are written directly by the stream and bulk writes are one copy
+	// capacity grown for a large message is given back after it has not been needed for DecayResets resets
 	template <typename T, size_t DefaultCapacity>
 	class VectorStreamBuffer : public std::basic_streambuf<T>
 	{
 		using Base = std::basic_streambuf<T>;
 		using BufferType = std::vector<T>;
+
+		static constexpr size_t DecayFactor = 16;
+		static constexpr unsigned int DecayResets = 8;
+
+		// size() is the capacity of the put area, the contents are [pbase, pptr)
 		BufferType buffer;
+		unsigned int smallResets {};
 
 	public:
 		using typename Base::int_type;
+		using typename Base::traits_type;
 
 		VectorStreamBuffer(size_t initialCapacity = DefaultCapacity)
 		{
-			buffer.reserve(initialCapacity);
+			buffer.resize(initialCapacity);
+			SetPutArea(0);
+		}
+
+		VectorStreamBuffer(const VectorStreamBuffer &) = delete;
+		VectorStreamBuffer & operator=(const VectorStreamBuffer &) = delete;
+		VectorStreamBuffer(VectorStreamBuffer &&) = delete;
+		VectorStreamBuffer & operator=(VectorStreamBuffer &&) = delete;
+		~VectorStreamBuffer() override = default;
+
+		std::basic_string_view<T> Get() const
+		{
+			return {this->pbase(), Size()};
+		}
+
+		size_t Size() const
+		{
+			return static_cast<size_t>(this->pptr() - this->pbase());
 		}
 
-		std::basic_string_view<T> Get()
+		size_t Capacity() const
 		{
-			return {buffer.data(), buffer.size()};
+			return buffer.size();
 		}
 
 		void Reset()
 		{
-			// decay size if large and not often used
-			// poss use list of chunks that can be shared?
-			buffer.clear();
-			buffer.reserve(DefaultCapacity);
+			Decay();
+			SetPutArea(0);
+		}
+
+		// hands the contents to the caller without copying, writing continues in new storage
+		BufferType Take()
+		{
+			buffer.resize(Size());
+			BufferType taken = std::move(buffer);
+			buffer = BufferType(DefaultCapacity);
+			smallResets = 0;
+			SetPutArea(0);
+			return taken;
 		}
 
 	protected:
 		int_type overflow(int_type c) override
 		{
-			if (Base::traits_type::eq_int_type(c, Base::traits_type::eof()))
+			if (traits_type::eq_int_type(c, traits_type::eof()))
 			{
-				return Base::traits_type::not_eof(c);
+				return traits_type::not_eof(c);
 			}
-			buffer.push_back(Base::traits_type::to_char_type(c));
+			Reserve(1);
+			*this->pptr() = traits_type::to_char_type(c);
+			this->pbump(1);
 			return c;
 		}
+
+		std::streamsize xsputn(const T * s, std::streamsize count) override
+		{
+			const auto size = static_cast<size_t>(count);
+			Reserve(size);
+			traits_type::copy(this->pptr(), s, size);
+			Bump(size);
+			return count;
+		}
+
+	private:
+		void Reserve(size_t count)
+		{
+			if (count <= static_cast<size_t>(this->epptr() - this->pptr()))
+			{
+				return;
+			}
+			const size_t size = Size();
+			buffer.resize(std::max(size + count, buffer.size() * 2));
+			SetPutArea(size);
+		}
+
+		void SetPutArea(size_t size)
+		{
+			this->setp(buffer.data(), buffer.data() + buffer.size());
+			Bump(size);
+		}
+
+		void Bump(size_t count)
+		{
+			for (; count > INT_MAX; count -= INT_MAX)
+			{
+				this->pbump(INT_MAX);
+			}
+			this->pbump(static_cast<int>(count));
+		}
+
+		void Decay()
+		{
+			constexpr size_t Retained = DefaultCapacity * DecayFactor;
+			if (buffer.size() <= Retained || Size() > Retained)
+			{
+				smallResets = 0;
+				return;
+			}
+
+			if (++smallResets == DecayResets)
+			{
+				BufferType {}.swap(buffer);
+				buffer.resize(DefaultCapacity);
+				smallResets = 0;
+			}
+		}
 	};
-}
\ No newline at end of file
+}